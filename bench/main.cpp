@@ -0,0 +1,351 @@
+#include "application/Application.hpp"
+#include "application/debug/Log.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct BenchOptions
+{
+    uint32_t WarmupFrames = 100;
+    uint32_t MeasuredFrames = 500;
+
+    std::string OutputPath = "bench_results.json";
+
+    bool HeadlessOnly = false;
+
+    std::vector<std::string> PresentModes = { "fifo", "mailbox", "immediate" };
+    std::vector<uint32_t> FramesInFlight = { 1, 2, 3 };
+    std::vector<uint32_t> DrawCounts = { 1, 256 };
+    std::vector<uint32_t> TrianglesPerDraw = { 2, 10000 };
+};
+
+struct BenchScenario
+{
+    bool Headless = false;
+
+    // Headless runs have no swapchain, they report "none"
+    std::string PresentMode;
+
+    uint32_t FramesInFlight = 2;
+    uint32_t DrawCount = 1;
+    uint32_t TrianglesPerDraw = 2;
+};
+
+struct BenchSummary
+{
+    size_t Samples = 0;
+    double Mean = 0.0;
+    double P50 = 0.0;
+    double P95 = 0.0;
+    double P99 = 0.0;
+};
+
+struct BenchResult
+{
+    BenchScenario Scenario;
+
+    // Empty when the scenario ran to completion
+    std::string Error;
+
+    BenchSummary Frame;
+    BenchSummary Cpu;
+    BenchSummary Wait;
+    BenchSummary Gpu;
+};
+
+static std::vector<std::string> SplitList(const std::string& list)
+{
+    std::vector<std::string> values;
+    std::stringstream stream(list);
+
+    std::string value;
+    while(std::getline(stream, value, ','))
+    {
+        if(!value.empty())
+            values.push_back(value);
+    }
+
+    return values;
+}
+
+static std::vector<uint32_t> ParseNumberList(const std::string& list)
+{
+    std::vector<uint32_t> numbers;
+
+    for(const std::string& value : SplitList(list))
+        numbers.push_back(std::max(1ul, std::stoul(value)));
+
+    return numbers;
+}
+
+static BenchOptions ParseOptions(int argc, char* argv[])
+{
+    BenchOptions options;
+
+    for(int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if(argument == "--warmup" && hasValue)
+            options.WarmupFrames = std::stoul(argv[++i]);
+        else if(argument == "--frames" && hasValue)
+            options.MeasuredFrames = std::max(1ul, std::stoul(argv[++i]));
+        else if(argument == "--output" && hasValue)
+            options.OutputPath = argv[++i];
+        else if(argument == "--headless-only")
+            options.HeadlessOnly = true;
+        else if(argument == "--present-modes" && hasValue)
+            options.PresentModes = SplitList(argv[++i]);
+        else if(argument == "--frames-in-flight" && hasValue)
+            options.FramesInFlight = ParseNumberList(argv[++i]);
+        else if(argument == "--draws" && hasValue)
+            options.DrawCounts = ParseNumberList(argv[++i]);
+        else if(argument == "--triangles" && hasValue)
+            options.TrianglesPerDraw = ParseNumberList(argv[++i]);
+        else
+            Log.Warn("Ignoring unknown argument ", argument);
+    }
+
+    return options;
+}
+
+static VkPresentModeKHR ToPresentMode(const std::string& name)
+{
+    if(name == "fifo")
+        return VK_PRESENT_MODE_FIFO_KHR;
+    if(name == "immediate")
+        return VK_PRESENT_MODE_IMMEDIATE_KHR;
+
+    return VK_PRESENT_MODE_MAILBOX_KHR;
+}
+
+static std::vector<BenchScenario> BuildScenarios(const BenchOptions& options)
+{
+    std::vector<BenchScenario> scenarios;
+
+    std::vector<std::string> headlessModes = { "none" };
+    std::vector<bool> targets = { true };
+    if(!options.HeadlessOnly)
+        targets.push_back(false);
+
+    for(bool headless : targets)
+    {
+        for(const std::string& presentMode : headless ? headlessModes : options.PresentModes)
+        {
+            for(uint32_t framesInFlight : options.FramesInFlight)
+            {
+                for(uint32_t drawCount : options.DrawCounts)
+                {
+                    for(uint32_t triangles : options.TrianglesPerDraw)
+                    {
+                        BenchScenario scenario;
+                        scenario.Headless = headless;
+                        scenario.PresentMode = presentMode;
+                        scenario.FramesInFlight = framesInFlight;
+                        scenario.DrawCount = drawCount;
+                        scenario.TrianglesPerDraw = triangles;
+
+                        scenarios.push_back(scenario);
+                    }
+                }
+            }
+        }
+    }
+
+    return scenarios;
+}
+
+// Nearest rank percentiles, |samples| gets sorted
+static BenchSummary Summarize(std::vector<double>& samples)
+{
+    BenchSummary summary;
+    summary.Samples = samples.size();
+
+    if(samples.empty())
+        return summary;
+
+    std::sort(samples.begin(), samples.end());
+
+    double total = 0.0;
+    for(double sample : samples)
+        total += sample;
+
+    auto percentile = [&](double p)
+    {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * samples.size()));
+        return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+    };
+
+    summary.Mean = total / samples.size();
+    summary.P50 = percentile(50.0);
+    summary.P95 = percentile(95.0);
+    summary.P99 = percentile(99.0);
+
+    return summary;
+}
+
+static BenchResult RunScenario(const BenchOptions& benchOptions, const BenchScenario& scenario, ApplicationDeviceInfo& deviceInfo)
+{
+    BenchResult result;
+    result.Scenario = scenario;
+
+    ApplicationOptions options;
+    options.Headless = scenario.Headless;
+    options.EnableValidation = false;
+    options.FrameCount = benchOptions.WarmupFrames + benchOptions.MeasuredFrames;
+    options.FramesInFlight = scenario.FramesInFlight;
+    options.PresentMode = ToPresentMode(scenario.PresentMode);
+    options.DrawCount = scenario.DrawCount;
+    options.TrianglesPerDraw = scenario.TrianglesPerDraw;
+    options.TracePath.clear();
+
+    // The bench window rarely keeps focus, throttling it would skew every windowed result
+    options.BackgroundFrameRate = 0.0;
+
+    std::vector<double> frame, cpu, wait, gpu;
+
+    try
+    {
+        Application application(options);
+        application.SetFrameCallback([&](const ApplicationFrameStats& stats)
+        {
+            if(stats.FrameNumber >= benchOptions.WarmupFrames)
+            {
+                frame.push_back(stats.FrameMilliseconds);
+                cpu.push_back(stats.CpuMilliseconds);
+                wait.push_back(stats.WaitMilliseconds);
+            }
+
+            // GPU timings trail behind, they're judged by the frame they came from
+            if(stats.GpuMilliseconds >= 0.0 && stats.GpuFrameNumber >= benchOptions.WarmupFrames)
+                gpu.push_back(stats.GpuMilliseconds);
+        });
+
+        application.Run();
+
+        deviceInfo = application.GetDeviceInfo();
+    }
+    catch(std::exception& exception)
+    {
+        Log.Error("Scenario failed: ", exception.what());
+        result.Error = exception.what();
+    }
+
+    result.Frame = Summarize(frame);
+    result.Cpu = Summarize(cpu);
+    result.Wait = Summarize(wait);
+    result.Gpu = Summarize(gpu);
+
+    return result;
+}
+
+static std::string EscapeJson(const std::string& text)
+{
+    std::string escaped;
+
+    for(char c : text)
+    {
+        if(c == '"' || c == '\\')
+            escaped.push_back('\\');
+
+        if(static_cast<unsigned char>(c) < 0x20)
+            escaped.push_back(' ');
+        else
+            escaped.push_back(c);
+    }
+
+    return escaped;
+}
+
+static void WriteSummary(std::ofstream& file, const char* name, const BenchSummary& summary, bool last)
+{
+    file << "        \"" << name << "\": { \"samples\": " << summary.Samples
+         << ", \"mean_ms\": " << summary.Mean
+         << ", \"p50_ms\": " << summary.P50
+         << ", \"p95_ms\": " << summary.P95
+         << ", \"p99_ms\": " << summary.P99 << " }" << (last ? "\n" : ",\n");
+}
+
+static bool WriteResults(const std::string& path, const BenchOptions& options, const ApplicationDeviceInfo& deviceInfo, const std::vector<BenchResult>& results)
+{
+    std::ofstream file(path);
+
+    if(!file.is_open())
+    {
+        Log.Error("Failed to open ", path, " for writing");
+        return false;
+    }
+
+    file << "{\n";
+    file << "  \"device\": { \"name\": \"" << EscapeJson(deviceInfo.DeviceName)
+         << "\", \"driver_version\": " << deviceInfo.DriverVersion
+         << ", \"api_version\": \"" << VK_API_VERSION_MAJOR(deviceInfo.ApiVersion) << "." << VK_API_VERSION_MINOR(deviceInfo.ApiVersion) << "." << VK_API_VERSION_PATCH(deviceInfo.ApiVersion) << "\" },\n";
+    file << "  \"warmup_frames\": " << options.WarmupFrames << ",\n";
+    file << "  \"measured_frames\": " << options.MeasuredFrames << ",\n";
+    file << "  \"scenarios\": [\n";
+
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult& result = results[i];
+        const BenchScenario& scenario = result.Scenario;
+
+        file << "    {\n";
+        file << "      \"target\": \"" << (scenario.Headless ? "headless" : "windowed") << "\",\n";
+        file << "      \"present_mode\": \"" << scenario.PresentMode << "\",\n";
+        file << "      \"frames_in_flight\": " << scenario.FramesInFlight << ",\n";
+        file << "      \"draws\": " << scenario.DrawCount << ",\n";
+        file << "      \"triangles_per_draw\": " << scenario.TrianglesPerDraw << ",\n";
+
+        if(!result.Error.empty())
+            file << "      \"error\": \"" << EscapeJson(result.Error) << "\",\n";
+
+        file << "      \"timings\": {\n";
+        WriteSummary(file, "frame", result.Frame, false);
+        WriteSummary(file, "cpu", result.Cpu, false);
+        WriteSummary(file, "wait", result.Wait, false);
+        WriteSummary(file, "gpu", result.Gpu, true);
+        file << "      }\n";
+        file << "    }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    file << "  ]\n";
+    file << "}\n";
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options = ParseOptions(argc, argv);
+    std::vector<BenchScenario> scenarios = BuildScenarios(options);
+
+    ApplicationDeviceInfo deviceInfo;
+    std::vector<BenchResult> results;
+
+    for(size_t i = 0; i < scenarios.size(); i++)
+    {
+        const BenchScenario& scenario = scenarios[i];
+
+        Log.Info("Scenario ", i + 1, "/", scenarios.size(), ": ", scenario.Headless ? "headless" : "windowed",
+            " present ", scenario.PresentMode,
+            " frames in flight ", scenario.FramesInFlight,
+            " draws ", scenario.DrawCount,
+            " triangles ", scenario.TrianglesPerDraw);
+
+        results.push_back(RunScenario(options, scenario, deviceInfo));
+
+        const BenchResult& result = results.back();
+        Log.Info("    frame p50 ", result.Frame.P50, " ms, p99 ", result.Frame.P99, " ms, gpu p50 ", result.Gpu.P50, " ms");
+    }
+
+    if(!WriteResults(options.OutputPath, options, deviceInfo, results))
+        return (EXIT_FAILURE);
+
+    Log.Info("Results written to ", options.OutputPath);
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,750 @@
+#include "Application.hpp"
+
+#include "sdl-wrap/SDLContextWrapper.hpp"
+#include "Window.hpp"
+
+#include "Vulkan/VulkanInstance.hpp"
+#include "Vulkan/DebugUtilsMessenger.hpp"
+#include "Vulkan/VulkanDeviceSelector.hpp"
+#include "Vulkan/VulkanDevice.hpp"
+#include "Vulkan/VulkanSwapchain.hpp"
+#include "Vulkan/VulkanImageView.hpp"
+#include "Vulkan/VulkanSemaphore.hpp"
+#include "Vulkan/VulkanRenderPass.hpp"
+#include "Vulkan/VulkanQueue.hpp"
+#include "Vulkan/VulkanSubmitBatch.hpp"
+#include "Vulkan/VulkanOffscreenTarget.hpp"
+#include "Vulkan/VulkanObjectRegistry.hpp"
+
+#include "RenderingContext.hpp"
+#include "TriangleRenderer.hpp"
+#include "BasicClock.hpp"
+#include "FramePacer.hpp"
+#include "debug/Profiler.hpp"
+#include "debug/BinaryLog.hpp"
+
+#include <SDL3/SDL.h>
+#include <Vulkan/vulkan.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <queue>
+#include <numeric>
+#include <cstring>
+#include <string>
+
+// Per message id counts, and the performance warnings table when asked for
+static void ReportValidation(const DebugUtilsMessenger* debugMessenger, const std::string& performanceWarningsPath)
+{
+    VulkanValidationAggregator* aggregator = debugMessenger ? debugMessenger->GetAggregator() : nullptr;
+    if(!aggregator)
+        return;
+
+    aggregator->Flush();
+    aggregator->LogSummary();
+
+    if(!performanceWarningsPath.empty())
+        aggregator->ExportPerformanceWarnings(performanceWarningsPath);
+}
+
+static std::unique_ptr<VulkanSwapchain> CreateSwapchain(std::shared_ptr<VulkanDevice> device, const VkSurfaceKHR& surface, const VulkanSwapchainPreferences& preferences, const VulkanSwapchain* oldSwapchain = nullptr)
+{
+    return std::make_unique<VulkanSwapchain>(device, surface, preferences, oldSwapchain);
+}
+
+// Present waits are tied to the image being presented, a semaphore per image can't be reused
+// while an earlier present of the same image is still pending
+static std::vector<std::unique_ptr<VulkanSemaphore>> CreatePresentSemaphores(std::shared_ptr<VulkanDevice> device, size_t imageCount)
+{
+    std::vector<std::unique_ptr<VulkanSemaphore>> semaphores;
+
+    for(size_t i = 0; i < imageCount; i++)
+        semaphores.emplace_back(std::make_unique<VulkanSemaphore>(device));
+
+    return semaphores;
+}
+
+static std::unique_ptr<VulkanSwapchain> RecreateSwapchain
+(
+    std::unique_ptr<VulkanSwapchain> swapchain,
+    const VkSurfaceKHR& surface,
+    const VulkanSwapchainPreferences& preferences,
+    std::shared_ptr<VulkanRenderPass> renderPass, 
+    std::vector<std::shared_ptr<VulkanFramebuffer>>& framebuffers,
+    std::vector<std::shared_ptr<VulkanSwapchainImage>>& swapchainImages,
+    std::vector<std::shared_ptr<VulkanImageView>>& imageViews,
+    std::vector<std::unique_ptr<VulkanSemaphore>>& presentSemaphores
+)
+{
+    PROFILE_ZONE("RecreateSwapchain");
+    VULKAN_OBJECT_SCOPE("RecreateSwapchain");
+
+    std::shared_ptr<VulkanDevice> device = swapchain->GetDevice();
+
+    // Formats and present modes stay cached, only the extent and transform need a fresh query
+    device->GetPhysicalDevice()->InvalidateSurfaceCapabilities(surface);
+
+    // Frames in flight keep running against the old swapchain. Releasing it and its views and framebuffers
+    // only queues their destruction until those frames have completed
+    std::unique_ptr<VulkanSwapchain> newSwapchain = CreateSwapchain(device, surface, preferences, swapchain.get());
+
+    framebuffers.clear();
+    imageViews.clear();
+    swapchainImages.clear();
+    presentSemaphores.clear();
+
+    swapchain = std::move(newSwapchain);
+
+    VkExtent2D extent = swapchain->GetExtent();
+    LOG_INFO(Swapchain, "Swapchain extent [", extent.width, ", ", extent.height, "]");
+
+    swapchainImages = swapchain->GetSwapchainImages();
+    
+    LOG_INFO(Swapchain, "Swapchain image count: ", swapchainImages.size());
+
+    for(std::shared_ptr<VulkanSwapchainImage> swapImage : swapchainImages)
+    {
+        imageViews.emplace_back(VulkanImageView::Create(swapImage));
+    }
+
+    for(auto view : imageViews)
+    {
+        framebuffers.emplace_back(std::make_shared<VulkanFramebuffer>(renderPass, view));
+    }
+
+    presentSemaphores = CreatePresentSemaphores(device, swapchainImages.size());
+
+    return swapchain;
+}
+
+struct RenderDevice
+{
+    std::shared_ptr<VulkanDeviceRequirements> Requirements;
+    std::shared_ptr<VulkanDevice> Device;
+
+    std::shared_ptr<VulkanQueue> GraphicsQueue;
+
+    // nullptr when the device has no dedicated family, the graphics queue does the work then
+    std::shared_ptr<VulkanQueue> TransferQueue;
+    std::shared_ptr<VulkanQueue> ComputeQueue;
+};
+
+static std::shared_ptr<VulkanInstance> CreateInstance(const ApplicationOptions& options, const std::string& applicationName, std::vector<const char*> extensions)
+{
+    VulkanInstanceCreateInfo createInfo;
+    createInfo.ApplicationName = applicationName;
+    createInfo.EnableValidationLayers = options.EnableValidation;
+    createInfo.Extensions = extensions;
+
+    // Build servers often come without the SDK, the layers are opt out there
+    if(options.EnableValidation)
+    {
+        createInfo.Extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+        createInfo.ValidationLayers = { "VK_LAYER_KHRONOS_validation" };
+    }
+
+    return VulkanInstance::Create(createInfo);
+}
+
+// Without a surface nothing swapchain related is requested, which is what lets software drivers like lavapipe qualify
+static RenderDevice CreateRenderDevice(std::shared_ptr<VulkanInstance> vulkanInstance, std::optional<VkSurfaceKHR> surface)
+{
+    VULKAN_OBJECT_SCOPE("CreateRenderDevice");
+
+    VulkanQueueRequest req1;
+    req1.Flags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_TRANSFER_BIT;
+    req1.Surface = surface;
+    req1.Count = 1;
+
+    // Uploads and compute work get queues of their own when the device has families for them
+    VulkanQueueRequest transferRequest;
+    transferRequest.Flags = VK_QUEUE_TRANSFER_BIT;
+    transferRequest.Count = 1;
+    transferRequest.Dedicated = true;
+    transferRequest.Optional = true;
+
+    VulkanQueueRequest computeRequest;
+    computeRequest.Flags = VK_QUEUE_COMPUTE_BIT;
+    computeRequest.Count = 1;
+    computeRequest.Dedicated = true;
+    computeRequest.Optional = true;
+
+    RenderDevice renderDevice;
+
+    std::shared_ptr<VulkanDeviceRequirements> requirements = VulkanDeviceRequirements::Create();
+    requirements->Queues.push_back(req1);
+    requirements->Queues.push_back(transferRequest);
+    requirements->Queues.push_back(computeRequest);
+    requirements->PipelineCachePath = "pipeline_cache.bin";
+
+    if(surface.has_value())
+        requirements->Extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+
+    renderDevice.Requirements = requirements;
+
+    LOG_INFO(DeviceSelection, "Creating device selector");
+    VulkanDeviceSelector selector(vulkanInstance, requirements);
+    
+    LOG_INFO(DeviceSelection, "Creating logical device");
+    renderDevice.Device = selector.GetDevice();
+
+    LOG_INFO(DeviceSelection, "Requesting test queue");
+    renderDevice.GraphicsQueue = renderDevice.Device->GetQueue(requirements->Queues[0], 0);
+
+    if(renderDevice.GraphicsQueue == VK_NULL_HANDLE)
+    {
+        Log.Error("Invalid queue handle");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    renderDevice.TransferQueue = renderDevice.Device->GetQueue(requirements->Queues[1], 0);
+    renderDevice.ComputeQueue = renderDevice.Device->GetQueue(requirements->Queues[2], 0);
+
+    LOG_INFO(DeviceSelection, "Dedicated transfer queue ", renderDevice.TransferQueue ? "available" : "unavailable", ", dedicated compute queue ", renderDevice.ComputeQueue ? "available" : "unavailable");
+
+    return renderDevice;
+}
+
+// Binary ppm, enough to look at the output without pulling in an image library
+static bool WriteFramePpm(const std::string& path, const VulkanOffscreenTarget& target)
+{
+    const uint8_t* pixels = static_cast<const uint8_t*>(target.ReadPixels());
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if(!pixels || !file.is_open())
+    {
+        Log.Error("Failed to write frame to ", path);
+        return false;
+    }
+
+    VkExtent2D extent = target.GetExtent();
+    bool bgra = target.GetFormat() == VK_FORMAT_B8G8R8A8_UNORM || target.GetFormat() == VK_FORMAT_B8G8R8A8_SRGB;
+
+    file << "P6\n" << extent.width << " " << extent.height << "\n255\n";
+
+    std::vector<char> row(extent.width * 3);
+    for(uint32_t y = 0; y < extent.height; y++)
+    {
+        for(uint32_t x = 0; x < extent.width; x++)
+        {
+            const uint8_t* pixel = pixels + (static_cast<size_t>(y) * extent.width + x) * 4;
+
+            row[x * 3 + 0] = pixel[bgra ? 2 : 0];
+            row[x * 3 + 1] = pixel[1];
+            row[x * 3 + 2] = pixel[bgra ? 0 : 2];
+        }
+
+        file.write(row.data(), row.size());
+    }
+
+    Log.Info("Wrote frame to ", path);
+    return true;
+}
+
+Application::Application(const ApplicationOptions& options)
+    : m_Options(options)
+{
+}
+
+void Application::Run()
+{
+    if(m_Options.Headless)
+        RunHeadless();
+    else
+        RunWindowed();
+
+    // Everything the run created is gone by now, whatever is still live leaked
+    VulkanObjectRegistry& registry = VulkanObjectRegistry::Get();
+    registry.LogCounters();
+
+    if(registry.GetLiveCount() > 0)
+    {
+        LOG_WARN(VulkanLifetime, registry.GetLiveCount(), " Vulkan objects outlived the run");
+        registry.LogLiveObjects();
+    }
+}
+
+void Application::FillDeviceInfo(VulkanDevice& device)
+{
+    const VkPhysicalDeviceProperties& properties = device.GetPhysicalDevice()->GetProperties();
+
+    m_DeviceInfo.DeviceName = properties.deviceName;
+    m_DeviceInfo.DriverVersion = properties.driverVersion;
+    m_DeviceInfo.ApiVersion = properties.apiVersion;
+}
+
+FramePacerCreateInfo Application::CreatePacerInfo() const
+{
+    FramePacerCreateInfo pacerInfo;
+    pacerInfo.TargetFrameRate = m_Options.TargetFrameRate;
+    pacerInfo.LowLatency = m_Options.LowLatency;
+
+    return pacerInfo;
+}
+
+void Application::ReportFrame
+(
+    uint64_t frameNumber,
+    BasicClock& clock,
+    std::chrono::high_resolution_clock::time_point renderBegin,
+    std::chrono::high_resolution_clock::time_point frameReady,
+    TriangleRenderer& renderer,
+    FramePacer& pacer
+)
+{
+    ApplicationFrameStats stats;
+    stats.FrameNumber = frameNumber;
+    stats.FrameMilliseconds = clock.DeltaSeconds() * 1000.0;
+    stats.WaitMilliseconds = std::chrono::duration<double, std::milli>(frameReady - renderBegin).count();
+    stats.CpuMilliseconds = clock.SecondsSince(frameReady) * 1000.0;
+
+    // Reported once, later frames see the same results until newer ones come back
+    const VulkanGpuFrameTimings& timings = renderer.GetGpuProfiler().GetLatestTimings();
+    if(!timings.Scopes.empty() && timings.FrameNumber != m_LastGpuFrameNumber)
+    {
+        m_LastGpuFrameNumber = timings.FrameNumber;
+
+        stats.GpuFrameNumber = timings.FrameNumber;
+        stats.GpuMilliseconds = timings.Scopes.front().Milliseconds;
+
+        pacer.ReportGpuTime(stats.GpuMilliseconds);
+    }
+
+    pacer.EndFrame(stats.CpuMilliseconds);
+
+    BINLOG_INFO(Frame, "Frame {} took {} ms, waited {} ms, cpu {} ms, gpu {} ms for frame {}",
+        stats.FrameNumber, stats.FrameMilliseconds, stats.WaitMilliseconds, stats.CpuMilliseconds, stats.GpuMilliseconds, stats.GpuFrameNumber);
+
+    stats.PacingErrorMilliseconds = pacer.GetLastErrorMilliseconds();
+    stats.AddedLatencyMilliseconds = pacer.GetLastAddedLatencyMilliseconds();
+
+    if(m_FrameCallback)
+        m_FrameCallback(stats);
+}
+
+void Application::RunHeadless()
+{
+    VULKAN_OBJECT_SCOPE("RunHeadless");
+
+    std::shared_ptr<VulkanInstance> vulkanInstance = CreateInstance(m_Options, "Vulkan-triangle headless", {});
+    
+    std::unique_ptr<DebugUtilsMessenger> debugMessenger = m_Options.EnableValidation ? std::make_unique<DebugUtilsMessenger>(vulkanInstance) : nullptr;
+
+    RenderDevice renderDevice = CreateRenderDevice(vulkanInstance, std::nullopt);
+    std::shared_ptr<VulkanDevice> device = renderDevice.Device;
+
+    FillDeviceInfo(*device);
+
+    const bool readback = !m_Options.ReadbackPath.empty();
+
+    TriangleRendererCreateInfo rendererInfo;
+    rendererInfo.ColorFormat = VK_FORMAT_B8G8R8A8_SRGB;
+    rendererInfo.FinalLayout = readback ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    rendererInfo.FramesInFlight = m_Options.FramesInFlight;
+    rendererInfo.DrawCount = m_Options.DrawCount;
+    rendererInfo.TrianglesPerDraw = m_Options.TrianglesPerDraw;
+
+    TriangleRenderer renderer(device, renderDevice.GraphicsQueue, renderDevice.TransferQueue, rendererInfo);
+
+    // A target per frame in flight, frames only wait on each other through the frame ring like they would on a swapchain
+    std::vector<std::unique_ptr<VulkanOffscreenTarget>> targets;
+    for(uint32_t i = 0; i < m_Options.FramesInFlight; i++)
+        targets.emplace_back(std::make_unique<VulkanOffscreenTarget>(device, renderer.GetRenderPass(), rendererInfo.ColorFormat, m_Options.Extent, readback));
+
+    Log.Info("Rendering ", m_Options.FrameCount, " headless frames [", m_Options.Extent.width, ", ", m_Options.Extent.height, "]");
+
+    Profiler::Get().SetThreadName("Main");
+
+    const VulkanOffscreenTarget* lastTarget = nullptr;
+
+    BasicClock clock;
+    FramePacer pacer(clock, CreatePacerInfo());
+    for(uint32_t frameNumber = 0; frameNumber < m_Options.FrameCount; frameNumber++)
+    {
+        PROFILE_ZONE("Frame");
+        VULKAN_OBJECT_SCOPE("Frame");
+
+        pacer.WaitForNextFrame();
+
+        clock.Tick();
+
+        auto renderBegin = clock.Now();
+
+        VulkanFrameContext& frame = renderer.BeginFrame();
+        const VulkanOffscreenTarget& target = *targets[frame.Index];
+
+        auto frameReady = clock.Now();
+
+        // Fixed time step, runs render the same frames no matter how fast they go
+        float time = frameNumber / 60.0f;
+
+        renderer.RecordFrame(frame, target.GetFramebuffer(), time, [&target](VulkanCommandBuffer& commandBuffer)
+        {
+            target.RecordReadback(commandBuffer);
+        });
+
+        VulkanSubmitBatch submission;
+        submission.AddCommandBuffer(*frame.CommandBuffer);
+
+        renderer.EndFrame(renderDevice.GraphicsQueue->Submit(submission));
+
+        lastTarget = &target;
+
+        ReportFrame(frameNumber, clock, renderBegin, frameReady, renderer, pacer);
+    }
+
+    device->WaitIdle();
+
+    float seconds = clock.Elapsed();
+    Log.Info("Rendered ", m_Options.FrameCount, " frames in ", seconds, " s, ", m_Options.FrameCount / seconds, " frames per second");
+
+    if(readback && lastTarget)
+        WriteFramePpm(m_Options.ReadbackPath, *lastTarget);
+
+    device->GetAllocator().LogStats();
+    renderer.LogStats();
+    pacer.LogStats();
+
+    ReportValidation(debugMessenger.get(), m_Options.PerformanceWarningsPath);
+
+    if(!m_Options.TracePath.empty())
+        Profiler::Get().WriteChromeTrace(m_Options.TracePath);
+}
+
+void Application::RunWindowed()
+{
+    VULKAN_OBJECT_SCOPE("RunWindowed");
+
+    SDLContextWrapper SDLContext(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+    Log.Info("SDLContext Initialized");
+    SDLContext.EnableVulkan();
+    
+    const WindowInfo info("Vulkan-triangle", m_Options.Extent.width, m_Options.Extent.height, SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY);
+
+    // The pointers are not automatically deleted :^)
+    std::shared_ptr<VulkanInstance> vulkanInstance = CreateInstance(m_Options, info.Title, SDLContext.GetVulkanInstanceExtensions());
+    
+    std::unique_ptr<DebugUtilsMessenger> debugMessenger = m_Options.EnableValidation ? std::make_unique<DebugUtilsMessenger>(vulkanInstance) : nullptr;
+
+    Window window(info);
+
+    int width = 0;
+    int height = 0;
+    SDL_GetWindowMinimumSize(window.GetNativeWindow(), &width, &height);
+    Log.Info("Window minimum size [", width, ", ", height, "]");
+
+    RenderingContext renderingContext(window, vulkanInstance);
+
+    RenderDevice renderDevice = CreateRenderDevice(vulkanInstance, renderingContext.GetSurface());
+    std::shared_ptr<VulkanDevice> device = renderDevice.Device;
+    std::shared_ptr<VulkanQueue> graphicsQueue = renderDevice.GraphicsQueue;
+
+    FillDeviceInfo(*device);
+
+    VulkanSwapchainPreferences swapchainPreferences;
+    swapchainPreferences.SurfaceFormat.format = VK_FORMAT_B8G8R8A8_SRGB;
+    swapchainPreferences.SurfaceFormat.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+    swapchainPreferences.PresentMode = m_Options.PresentMode;
+    swapchainPreferences.ImageCount = 0; // Driver minimum plus one
+    swapchainPreferences.ImageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    swapchainPreferences.SharingMode = VK_SHARING_MODE_CONCURRENT;
+    swapchainPreferences.QueueFamilyIndices = renderDevice.Requirements->Queues[0].GetFamilyIndices();
+    swapchainPreferences.CompositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+
+    std::unique_ptr<VulkanSwapchain> swapchain = CreateSwapchain(device, renderingContext.GetSurface(), swapchainPreferences);
+
+    std::vector<std::shared_ptr<VulkanSwapchainImage>> swapchainImages = swapchain->GetSwapchainImages();
+    
+    LOG_INFO(Swapchain, "Swapchain image count: ", swapchainImages.size());
+
+    std::vector<std::shared_ptr<VulkanImageView>> imageViews;
+    for(std::shared_ptr<VulkanSwapchainImage> swapImage : swapchainImages)
+    {
+        imageViews.emplace_back(VulkanImageView::Create(swapImage));
+    }
+
+    std::vector<std::unique_ptr<VulkanSemaphore>> presentSemaphores = CreatePresentSemaphores(device, swapchainImages.size());
+
+    TriangleRendererCreateInfo rendererInfo;
+    rendererInfo.ColorFormat = swapchain->GetSurfaceFormat().format;
+    rendererInfo.FinalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    rendererInfo.FramesInFlight = m_Options.FramesInFlight;
+    rendererInfo.DrawCount = m_Options.DrawCount;
+    rendererInfo.TrianglesPerDraw = m_Options.TrianglesPerDraw;
+
+    TriangleRenderer renderer(device, graphicsQueue, renderDevice.TransferQueue, rendererInfo);
+
+    std::vector<std::shared_ptr<VulkanFramebuffer>> framebuffers;
+    for(auto view : imageViews)
+    {
+        framebuffers.emplace_back(std::make_shared<VulkanFramebuffer>(renderer.GetRenderPass(), view));
+    }
+
+    bool framebufferResized = false;
+    bool minimized = false;
+    bool hidden = false;
+
+    std::deque<float> frameTimes;
+    const int MAX_RECORDED_FRAME_TIMES = 20;
+
+    // Upper bound on how long an idle window blocks for events before the loop conditions are checked again
+    const int IDLE_EVENT_TIMEOUT_MS = 250;
+
+    Log.Info("Entering EventLoop");
+
+    Profiler::Get().SetThreadName("Main");
+
+    uint64_t frameNumber = 0;
+
+    BasicClock clock;
+    FramePacer pacer(clock, CreatePacerInfo());
+    while(window.IsOpen() && (m_Options.FrameCount == 0 || frameNumber < m_Options.FrameCount))
+    {
+        PROFILE_ZONE("Frame");
+        VULKAN_OBJECT_SCOPE("Frame");
+
+        // Nothing is drawn while minimized or hidden, so block on the event queue instead of spinning through the loop
+        const bool idle = minimized || hidden;
+
+        if(!idle)
+            pacer.WaitForNextFrame();
+
+        clock.Tick();
+
+        // The average is only for the trace, so it's only computed when the trace is built in and enabled
+        if constexpr(LogIsCompiledIn(LogLevel::Trace, LogCategory::Frame))
+        {
+            if(frameTimes.size() >= MAX_RECORDED_FRAME_TIMES)
+                frameTimes.pop_front();
+
+            frameTimes.push_back(1.0f / clock.DeltaSeconds());
+
+            LOG_TRACE(Frame, "Frame ", frameNumber, " took ", clock.DeltaSeconds() * 1000.0f, " ms, FPS ",
+                std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0f) / frameTimes.size());
+        }
+        // SDL_SetWindowTitle(window.GetNativeWindow(), message.c_str());
+
+        ProfilerZone pollZone("PollEvents");
+
+        SDL_Event e;
+        bool hasEvent = idle ? SDL_WaitEventTimeout(&e, IDLE_EVENT_TIMEOUT_MS) : SDL_PollEvent(&e);
+        while(hasEvent)
+        {
+            switch(e.type)
+            {
+                case SDL_EVENT_WINDOW_CLOSE_REQUESTED:
+                    window.Close();
+                break;
+                case SDL_EVENT_KEY_DOWN:
+                {
+                    if(e.key.keysym.sym == SDLK_ESCAPE)
+                        window.Close();
+                    
+                    // An empty path only turns off the trace written on exit, P still asks for one
+                    if(e.key.keysym.sym == SDLK_p)
+                        Profiler::Get().WriteChromeTrace(m_Options.TracePath.empty() ? "profile.json" : m_Options.TracePath);
+
+                    if(e.key.keysym.sym == SDLK_l)
+                    {
+                        VulkanObjectRegistry::Get().LogCounters();
+                        VulkanObjectRegistry::Get().LogLiveObjects();
+                    }
+
+                    if(e.key.keysym.sym == SDLK_o)
+                    {
+                        int width = 0;
+                        int height = 0;
+
+                        SDL_GetWindowSizeInPixels(window.GetNativeWindow(), &width, &height);
+                        SDL_SetWindowSize(window.GetNativeWindow(), width, 1);
+                    }
+                } break;
+                case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+                {
+                    Log.Info("Size changed?");
+                } break;
+                case SDL_EVENT_WINDOW_RESIZED:
+                {
+                    framebufferResized = true;
+                    int width = 0;
+                    int height = 0;
+
+                    int result = SDL_GetWindowSizeInPixels(window.GetNativeWindow(), &width, &height);
+                    if(result != 0)
+                        Log.Warn("GetWindowSizeInPixels failed");
+                    Log.Info("Window size changed [", width, ", ", height, "]"); 
+
+                    result = SDL_GetWindowSize(window.GetNativeWindow(), &width, &height);
+                    if(result != 0)
+                        Log.Warn("GetWindowSize failed");
+                    Log.Info("Window size changed [", width, ", ", height, "]");
+
+                    device->GetPhysicalDevice()->InvalidateSurfaceCapabilities(renderingContext.GetSurface());
+
+                    const SwapchainSupportDetails& details = device->GetSwapchainSupportDetails(renderingContext.GetSurface());
+                    VkExtent2D extent = details.Capabilities.currentExtent;
+                    LOG_INFO(Swapchain, "SwapchainDetails extent [", extent.width, ", ", extent.height, "]");
+                    
+                    if(width == 0 || height == 0)
+                    {
+                        Log.Info("Minimized");
+                        minimized = true;
+                    }
+                    else
+                    {
+                        Log.Info("Not minimized");
+                        minimized = false;
+                    }
+                    //swapchain = RecreateSwapchain(std::move(swapchain), renderingContext.GetSurface(), swapchainPreferences, renderPass, framebuffers);
+                } break;
+                case SDL_EVENT_WINDOW_MINIMIZED:
+                {
+                    Log.Info("Minimized"); 
+                    
+                    int result = SDL_GetWindowSizeInPixels(window.GetNativeWindow(), &width, &height);
+                    if(result != 0)
+                        Log.Warn("GetWindowSizeInPixels failed");
+                    Log.Info("Window size changed [", width, ", ", height, "]"); 
+                    
+                    minimized = true;
+                } break;
+                case SDL_EVENT_WINDOW_RESTORED:
+                {
+                    Log.Info("Restored");
+                    minimized = false;
+                } break;
+                case SDL_EVENT_WINDOW_HIDDEN:
+                {
+                    Log.Info("Hidden");
+                    hidden = true;
+                } break;
+                case SDL_EVENT_WINDOW_SHOWN:
+                {
+                    Log.Info("Shown");
+                    hidden = false;
+                } break;
+                case SDL_EVENT_WINDOW_FOCUS_LOST:
+                {
+                    // Keep drawing in the background, just not at full rate
+                    if(m_Options.BackgroundFrameRate > 0.0)
+                    {
+                        double rate = m_Options.BackgroundFrameRate;
+                        if(m_Options.TargetFrameRate > 0.0)
+                            rate = std::min(rate, m_Options.TargetFrameRate);
+
+                        pacer.SetTargetFrameRate(rate);
+                    }
+                } break;
+                case SDL_EVENT_WINDOW_FOCUS_GAINED:
+                {
+                    pacer.SetTargetFrameRate(m_Options.TargetFrameRate);
+                } break;
+            }
+
+            hasEvent = SDL_PollEvent(&e);
+        }
+
+        pollZone.End();
+        
+        if(!window.IsOpen())
+            Log.Info("Window close requested");
+
+        if(minimized || hidden)
+            continue;
+
+        auto renderBegin = clock.Now();
+
+        VulkanFrameContext& frame = renderer.BeginFrame();
+
+        auto frameReady = clock.Now();
+
+        VulkanSwapchain::AcquisitionResult swapchainAcquisition = swapchain->AcquireNextImage(frame.ImageAvailableSemaphore.get());
+        VkResult swapchainState = swapchainAcquisition.Result;
+
+        // Nothing was acquired, the semaphore is unsignaled and the frame can simply be skipped
+        if(swapchainState == VK_ERROR_OUT_OF_DATE_KHR)
+        {
+            swapchain = RecreateSwapchain
+            (
+                std::move(swapchain),
+                renderingContext.GetSurface(),
+                swapchainPreferences,
+                renderer.GetRenderPass(),
+                framebuffers,
+                swapchainImages,
+                imageViews,
+                presentSemaphores
+            );
+
+            continue;
+        }
+        else if(swapchainState != VK_SUCCESS && swapchainState != VK_SUBOPTIMAL_KHR)
+        {
+            Log.Error("Failed to acquire swapchain image");
+            throw std::runtime_error("Vulkan error");
+        }
+
+        renderer.RecordFrame(frame, *framebuffers[swapchainAcquisition.ImageIndex], clock.Elapsed());
+
+        VulkanSemaphore* presentSemaphore = presentSemaphores[swapchainAcquisition.ImageIndex].get();
+
+        // Passes recorded into separate command buffers join the same batch and go out in one submit
+        VulkanSubmitBatch submission;
+        submission.Wait(*frame.ImageAvailableSemaphore, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT)
+            .AddCommandBuffer(*frame.CommandBuffer)
+            .Signal(*presentSemaphore);
+
+        uint64_t timelineValue = graphicsQueue->Submit(submission);
+
+        renderer.EndFrame(timelineValue);
+
+        VkResult presentResult = graphicsQueue->Present(swapchainAcquisition.ImageIndex, *swapchain, presentSemaphore);
+
+        // A suboptimal acquire still rendered this frame, recreate now that the image has been handed back
+        if(presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR || swapchainState == VK_SUBOPTIMAL_KHR || framebufferResized)
+        {
+            if(presentResult == VK_ERROR_OUT_OF_DATE_KHR)
+                LOG_INFO(Swapchain, "PresentResult out of date");
+            else if(presentResult == VK_SUBOPTIMAL_KHR)
+                LOG_INFO(Swapchain, "PresentResult suboptimal");
+
+            framebufferResized = false;
+            
+            swapchain = RecreateSwapchain
+            (
+                std::move(swapchain),
+                renderingContext.GetSurface(),
+                swapchainPreferences,
+                renderer.GetRenderPass(),
+                framebuffers,
+                swapchainImages,
+                imageViews,
+                presentSemaphores
+            );            
+        }
+        else if(presentResult != VK_SUCCESS)
+        {
+            Log.Error("Failed to present swapchain image");
+            throw std::runtime_error("Vulkan error");
+        }
+
+        ReportFrame(frameNumber++, clock, renderBegin, frameReady, renderer, pacer);
+    }
+    
+    device->WaitIdle();
+
+    device->GetAllocator().LogStats();
+    renderer.LogStats();
+    pacer.LogStats();
+
+    ReportValidation(debugMessenger.get(), m_Options.PerformanceWarningsPath);
+
+    if(!m_Options.TracePath.empty())
+        Profiler::Get().WriteChromeTrace(m_Options.TracePath);
+
+    const VulkanSurfaceCacheStats& surfaceCacheStats = device->GetPhysicalDevice()->GetSurfaceCacheStats();
+    Log.Info("Surface cache ", surfaceCacheStats.Hits, " hits, ", surfaceCacheStats.Misses, " misses, ", surfaceCacheStats.CapabilityRefreshes, " capability refreshes");
+
+    Log.Info("Exiting EventLoop");
+}
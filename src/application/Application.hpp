@@ -0,0 +1,119 @@
+#pragma once
+
+#include "BasicClock.hpp"
+#include "FramePacer.hpp"
+
+#include <Vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+class VulkanDevice;
+class TriangleRenderer;
+
+struct ApplicationOptions
+{
+    // Renders into offscreen images, without SDL, a window or a swapchain
+    bool Headless = false;
+    bool EnableValidation = true;
+
+    // Frames to render before returning, 0 keeps going until the window is closed. Headless runs need a count
+    uint32_t FrameCount = 0;
+    uint32_t FramesInFlight = 2;
+
+    VkExtent2D Extent = { 720, 300 };
+    VkPresentModeKHR PresentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+
+    uint32_t DrawCount = 1;
+    uint32_t TrianglesPerDraw = 2;
+
+    // Frame cap, 0 leaves the loop running as fast as the present mode allows
+    double TargetFrameRate = 0.0;
+
+    // Frame cap while the window doesn't have focus, 0 keeps the regular rate
+    double BackgroundFrameRate = 30.0;
+
+    // Delays the start of each frame so input is sampled as late as the measured frame times allow
+    bool LowLatency = false;
+
+    // Headless only. When set every frame is copied back and the last one written here as a ppm
+    std::string ReadbackPath;
+
+    // Validation only. Performance warnings from the layers are exported here as CSV on exit
+    std::string PerformanceWarningsPath;
+
+    // Chrome trace of the CPU zones written on exit, nothing is written when empty
+    std::string TracePath = "profile.json";
+};
+
+struct ApplicationFrameStats
+{
+    uint64_t FrameNumber = 0;
+
+    // Wall time since the previous frame started
+    double FrameMilliseconds = 0.0;
+
+    // Time spent waiting for the frame context to retire
+    double WaitMilliseconds = 0.0;
+
+    // Everything else the CPU did for the frame: recording, submission and present
+    double CpuMilliseconds = 0.0;
+
+    // GPU timings come back a few frames late, these belong to |GpuFrameNumber|. Negative when nothing new came back
+    uint64_t GpuFrameNumber = 0;
+    double GpuMilliseconds = -1.0;
+
+    // How late the frame pacer started the frame, and how long it held it back. Zero when pacing is off
+    double PacingErrorMilliseconds = 0.0;
+    double AddedLatencyMilliseconds = 0.0;
+};
+
+struct ApplicationDeviceInfo
+{
+    std::string DeviceName;
+    uint32_t DriverVersion = 0;
+    uint32_t ApiVersion = 0;
+};
+
+using ApplicationFrameCallback = std::function<void(const ApplicationFrameStats& stats)>;
+
+// Sets up Vulkan and runs the render loop, either presenting to a window or rendering offscreen
+class Application
+{
+public:
+    Application(const ApplicationOptions& options);
+
+    // Returns once the window is closed or the frame count is reached
+    void Run();
+
+    // Called on the render thread after every submitted frame
+    void SetFrameCallback(ApplicationFrameCallback callback) { m_FrameCallback = std::move(callback); }
+
+    // Filled in once Run has picked a device
+    const ApplicationDeviceInfo& GetDeviceInfo() const { return m_DeviceInfo; }
+
+private:
+    void RunHeadless();
+    void RunWindowed();
+
+    void FillDeviceInfo(VulkanDevice& device);
+    FramePacerCreateInfo CreatePacerInfo() const;
+
+    // Feeds the frame's timings to the pacer and the frame callback, |frameReady| is when the frame context became free
+    void ReportFrame(
+        uint64_t frameNumber,
+        BasicClock& clock,
+        std::chrono::high_resolution_clock::time_point renderBegin,
+        std::chrono::high_resolution_clock::time_point frameReady,
+        TriangleRenderer& renderer,
+        FramePacer& pacer
+    );
+
+private:
+    ApplicationOptions m_Options;
+    ApplicationFrameCallback m_FrameCallback;
+    ApplicationDeviceInfo m_DeviceInfo;
+
+    uint64_t m_LastGpuFrameNumber = UINT64_MAX;
+};
@@ -0,0 +1,123 @@
+#include "FramePacer.hpp"
+
+#include "debug/Log.hpp"
+#include "debug/Profiler.hpp"
+
+#include <algorithm>
+#include <thread>
+
+static double UpdateEstimate(double estimate, double sample)
+{
+    return std::max(sample, estimate * 0.95 + sample * 0.05);
+}
+
+FramePacer::FramePacer(BasicClock& clock, const FramePacerCreateInfo& createInfo)
+    : m_Clock(clock),
+    m_Period(0.0),
+    m_LowLatency(createInfo.LowLatency),
+    m_Spin(createInfo.SpinMilliseconds),
+    m_SafetyMargin(createInfo.SafetyMarginMilliseconds),
+    m_Deadline(clock.Now()),
+    m_CpuEstimate(0.0),
+    m_GpuEstimate(0.0),
+    m_LastError(0.0),
+    m_LastAddedLatency(0.0),
+    m_Frames(0),
+    m_TotalError(0.0),
+    m_MaxError(0.0),
+    m_TotalAddedLatency(0.0)
+{
+    SetTargetFrameRate(createInfo.TargetFrameRate);
+}
+
+void FramePacer::WaitForNextFrame()
+{
+    if(!IsEnabled())
+        return;
+
+    PROFILE_ZONE("FramePacing");
+
+    TimePoint ready = m_Clock.Now();
+
+    // Uncapped low latency runs at whatever rate the GPU sustains, without letting frames queue up behind it
+    Milliseconds period = std::max(m_Period, Milliseconds(m_GpuEstimate));
+
+    // Capped frames start one period before they are due, low latency ones only as early as the work needs
+    Milliseconds lead = m_LowLatency
+        ? std::min(period, Milliseconds(m_CpuEstimate + m_GpuEstimate) + m_SafetyMargin)
+        : period;
+
+    m_Deadline += std::chrono::duration_cast<TimePoint::duration>(period);
+    TimePoint target = m_Deadline - std::chrono::duration_cast<TimePoint::duration>(lead);
+
+    // Fell behind, start over from now instead of rushing out frames to catch up
+    if(target < ready)
+    {
+        target = ready;
+        m_Deadline = ready + std::chrono::duration_cast<TimePoint::duration>(lead);
+    }
+
+    WaitUntil(target);
+
+    TimePoint start = m_Clock.Now();
+
+    m_LastError = Milliseconds(start - target).count();
+    m_LastAddedLatency = Milliseconds(start - ready).count();
+
+    m_Frames++;
+    m_TotalError += m_LastError;
+    m_MaxError = std::max(m_MaxError, m_LastError);
+    m_TotalAddedLatency += m_LastAddedLatency;
+}
+
+void FramePacer::EndFrame(double cpuMilliseconds)
+{
+    m_CpuEstimate = UpdateEstimate(m_CpuEstimate, cpuMilliseconds);
+}
+
+void FramePacer::ReportGpuTime(double gpuMilliseconds)
+{
+    m_GpuEstimate = UpdateEstimate(m_GpuEstimate, gpuMilliseconds);
+}
+
+void FramePacer::SetTargetFrameRate(double targetFrameRate)
+{
+    m_Period = Milliseconds(targetFrameRate > 0.0 ? 1000.0 / targetFrameRate : 0.0);
+}
+
+FramePacerStats FramePacer::GetStats() const
+{
+    FramePacerStats stats;
+    stats.Frames = m_Frames;
+
+    if(m_Frames > 0)
+    {
+        stats.MeanErrorMilliseconds = m_TotalError / m_Frames;
+        stats.MaxErrorMilliseconds = m_MaxError;
+        stats.MeanAddedLatencyMilliseconds = m_TotalAddedLatency / m_Frames;
+    }
+
+    return stats;
+}
+
+void FramePacer::LogStats() const
+{
+    if(!IsEnabled())
+        return;
+
+    FramePacerStats stats = GetStats();
+
+    Log.Info("Frame pacing ", stats.Frames, " frames, error mean ", stats.MeanErrorMilliseconds, " ms max ", stats.MaxErrorMilliseconds, " ms, added latency mean ", stats.MeanAddedLatencyMilliseconds, " ms");
+}
+
+void FramePacer::WaitUntil(TimePoint target) const
+{
+    // Sleeping wakes up late by up to a scheduler tick, so stop sleeping a little early and spin the rest
+    TimePoint spinFrom = target - std::chrono::duration_cast<TimePoint::duration>(m_Spin);
+
+    if(m_Clock.Now() < spinFrom)
+        std::this_thread::sleep_until(spinFrom);
+
+    while(m_Clock.Now() < target)
+        std::this_thread::yield();
+}
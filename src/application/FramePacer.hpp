@@ -0,0 +1,91 @@
+#pragma once
+
+#include "BasicClock.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+struct FramePacerCreateInfo
+{
+    // Frames per second the loop is held to, 0 leaves it uncapped
+    double TargetFrameRate = 0.0;
+
+    // Starts each frame as late as the measured CPU and GPU times allow, so input is sampled right before
+    // the frame is built. Without a target rate frames are paced to the GPU frame time
+    bool LowLatency = false;
+
+    // The OS sleep overshoots, the last stretch before a deadline is spun instead
+    double SpinMilliseconds = 1.5;
+
+    // Slack kept in front of the estimated frame time in low latency mode
+    double SafetyMarginMilliseconds = 1.0;
+};
+
+struct FramePacerStats
+{
+    uint64_t Frames = 0;
+
+    // How late frames started relative to when the pacer meant to start them
+    double MeanErrorMilliseconds = 0.0;
+    double MaxErrorMilliseconds = 0.0;
+
+    // Time the pacer held frames back after the loop was ready to start them
+    double MeanAddedLatencyMilliseconds = 0.0;
+};
+
+// Decides when the next frame starts. Call WaitForNextFrame at the top of the loop, before input is polled,
+// and feed back how long the frame took with EndFrame and ReportGpuTime
+class FramePacer
+{
+public:
+    FramePacer(BasicClock& clock, const FramePacerCreateInfo& createInfo);
+
+    // Sleeps, then spins, until the next frame is due. Returns right away when pacing is off
+    void WaitForNextFrame();
+
+    // CPU time the frame spent building and submitting, waits on the GPU excluded
+    void EndFrame(double cpuMilliseconds);
+
+    // GPU time of a finished frame, these come back a few frames late
+    void ReportGpuTime(double gpuMilliseconds);
+
+    // Takes effect from the next frame, 0 uncaps
+    void SetTargetFrameRate(double targetFrameRate);
+
+    bool IsEnabled() const { return m_Period.count() > 0.0 || m_LowLatency; }
+
+    double GetLastErrorMilliseconds() const { return m_LastError; }
+    double GetLastAddedLatencyMilliseconds() const { return m_LastAddedLatency; }
+
+    FramePacerStats GetStats() const;
+    void LogStats() const;
+
+private:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    void WaitUntil(TimePoint target) const;
+
+private:
+    BasicClock& m_Clock;
+
+    Milliseconds m_Period;
+    bool m_LowLatency;
+    Milliseconds m_Spin;
+    Milliseconds m_SafetyMargin;
+
+    // When the frame being paced is expected to be done
+    TimePoint m_Deadline;
+
+    // Rise immediately, decay slowly. Underestimating makes a frame miss its deadline
+    double m_CpuEstimate;
+    double m_GpuEstimate;
+
+    double m_LastError;
+    double m_LastAddedLatency;
+
+    uint64_t m_Frames;
+    double m_TotalError;
+    double m_MaxError;
+    double m_TotalAddedLatency;
+};
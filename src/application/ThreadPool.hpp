@@ -0,0 +1,106 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed number of worker threads pulling jobs off a FIFO queue.
+// Jobs still queued when the pool is destroyed are run before the workers exit
+class ThreadPool
+{
+public:
+    ThreadPool(uint32_t workerCount = DefaultWorkerCount())
+    {
+        if(workerCount == 0)
+            workerCount = 1;
+
+        for(uint32_t i = 0; i < workerCount; i++)
+            m_Workers.emplace_back([this]() { WorkerLoop(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+        }
+
+        m_Condition.notify_all();
+
+        for(std::thread& worker : m_Workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template<typename F>
+    std::future<std::invoke_result_t<F>> Submit(F&& function)
+    {
+        using ResultT = std::invoke_result_t<F>;
+
+        // std::function needs a copyable target, packaged_task isn't one
+        auto task = std::make_shared<std::packaged_task<ResultT()>>(std::forward<F>(function));
+        std::future<ResultT> future = task->get_future();
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Jobs.emplace([task]() { (*task)(); });
+        }
+
+        m_Condition.notify_one();
+
+        return future;
+    }
+
+    // Jobs waiting for a worker, not counting the ones being run
+    size_t GetQueueDepth() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_Jobs.size();
+    }
+
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+    // Leaves one hardware thread for the thread submitting the work
+    static uint32_t DefaultWorkerCount()
+    {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+private:
+    void WorkerLoop()
+    {
+        while(true)
+        {
+            std::function<void()> job;
+
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Condition.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+
+                if(m_Jobs.empty())
+                    return;
+
+                job = std::move(m_Jobs.front());
+                m_Jobs.pop();
+            }
+
+            job();
+        }
+    }
+
+private:
+    std::vector<std::thread> m_Workers;
+    std::queue<std::function<void()>> m_Jobs;
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    bool m_Stopping = false;
+};
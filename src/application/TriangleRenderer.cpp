@@ -0,0 +1,404 @@
+#include "TriangleRenderer.hpp"
+
+#include "Vulkan/VulkanAttachmentDescription.hpp"
+#include "Vulkan/VulkanAttachmentReference.hpp"
+#include "Vulkan/VulkanSubpassDescription.hpp"
+#include "Vulkan/VulkanSubpassDependency.hpp"
+#include "Vulkan/VulkanPipelineShaderStage.hpp"
+#include "Vulkan/VulkanPipelineDynamicState.hpp"
+#include "Vulkan/VulkanPipelineVertexInputState.hpp"
+#include "Vulkan/VulkanPipelineInputAssemblyState.hpp"
+#include "Vulkan/VulkanPipelineViewportState.hpp"
+#include "Vulkan/VulkanPipelineRasterizationState.hpp"
+#include "Vulkan/VulkanPipelineMultisampleState.hpp"
+#include "Vulkan/VulkanPipelineColorBlendAttachment.hpp"
+#include "Vulkan/VulkanPipelineColorBlendState.hpp"
+#include "Vulkan/VulkanPipelineDepthStencilState.hpp"
+#include "Vulkan/VulkanGraphicsPipelineDescription.hpp"
+#include "Vulkan/VulkanViewport.hpp"
+#include "Vulkan/VulkanRect2D.hpp"
+#include "Vulkan/VulkanObjectRegistry.hpp"
+#include "debug/Profiler.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <fstream>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+struct Vertex
+{
+    glm::vec2 Position;
+    glm::vec3 Color;
+};
+
+static std::vector<char> ReadFile(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::ate | std::ios::binary);
+
+    if(!file.is_open())
+    {
+        throw std::runtime_error("Failed to open " + filename + " for reading");
+    }
+
+    size_t fileSize = static_cast<size_t>(file.tellg());
+
+    std::vector<char> buffer(fileSize);
+    file.seekg(0);
+    file.read(buffer.data(), fileSize);
+    file.close();
+
+    return buffer;
+}
+
+TriangleRenderer::TriangleRenderer
+(
+    std::shared_ptr<VulkanDevice> device,
+    std::shared_ptr<VulkanQueue> graphicsQueue,
+    std::shared_ptr<VulkanQueue> transferQueue,
+    const TriangleRendererCreateInfo& createInfo
+)
+    : m_Device(device), m_GraphicsQueue(graphicsQueue), m_IndexCount(0), m_IndexType(VK_INDEX_TYPE_UINT16), m_DrawCount(createInfo.DrawCount)
+{
+    VULKAN_OBJECT_SCOPE("TriangleRenderer");
+
+    CreateRenderPass(createInfo);
+    CreatePipeline(createInfo);
+    CreateGeometry(createInfo, transferQueue);
+
+    m_FrameRing = std::make_unique<VulkanFrameContextRing>(device, graphicsQueue, createInfo.FramesInFlight, 64 * 1024, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    m_GpuProfiler = std::make_unique<VulkanGpuProfiler>(device, graphicsQueue->GetFamilyIndex(), createInfo.FramesInFlight);
+
+    LOG_DEBUG(VulkanLifetime, "TriangleRenderer created");
+}
+
+TriangleRenderer::~TriangleRenderer()
+{
+}
+
+VulkanFrameContext& TriangleRenderer::BeginFrame()
+{
+    VulkanFrameContext& frame = m_FrameRing->BeginFrame();
+
+    m_Device->GetPipelineCache().SaveIfDue();
+
+    return frame;
+}
+
+void TriangleRenderer::RecordFrame(VulkanFrameContext& frame, const VulkanFramebuffer& framebuffer, float time, const TriangleRendererPostPass& postPass)
+{
+    PROFILE_ZONE("RecordCommandBuffer");
+
+    glm::vec2 instanceOffset = { 0.25f * std::sin(time), 0.0f };
+    VulkanUploadAllocation instanceData = m_FrameRing->GetUploadRing().Upload(&instanceOffset, sizeof(instanceOffset));
+    m_FrameRing->GetUploadRing().Flush();
+
+    // Pipeline may still be compiling, the pass still runs so the clear happens
+    const VulkanPipeline* pipeline = m_PipelineCompiler->Resolve(m_GraphicsPipeline).get();
+    uint32_t drawCount = pipeline ? m_DrawCount : 0;
+
+    VulkanCommandBuffer& commandBuffer = *frame.CommandBuffer;
+    VulkanGpuProfiler& profiler = *m_GpuProfiler;
+
+    commandBuffer.Begin();
+
+    profiler.BeginFrame(commandBuffer, frame.Index);
+    commandBuffer.BeginScope(profiler, "Frame");
+    
+    VkExtent2D extent = framebuffer.GetExtent();
+
+    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+
+    commandBuffer.BeginScope(profiler, "MainPass");
+
+    m_FrameRing->GetCommandRecorder().RecordRenderPass(
+        commandBuffer,
+        *m_RenderPass,
+        framebuffer,
+        VulkanRect2D(0, 0, extent.width, extent.height),
+        clearColor,
+        drawCount,
+        [&](VulkanCommandBuffer& rangeBuffer, uint32_t firstDraw, uint32_t rangeDrawCount)
+        {
+            rangeBuffer.BindPipeline(*pipeline, VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+            VulkanViewport viewport(0, 0, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f);
+            rangeBuffer.SetViewport(viewport);
+
+            VulkanRect2D scissor(extent);
+            rangeBuffer.SetScissor(scissor);
+
+            rangeBuffer.BindVertexBuffers(0, { m_VertexBuffer.get(), instanceData.Buffer }, { 0, instanceData.Offset });
+            rangeBuffer.BindIndexBuffer(*m_IndexBuffer, m_IndexType);
+
+            for(uint32_t draw = firstDraw; draw < firstDraw + rangeDrawCount; draw++)
+                rangeBuffer.DrawIndexed(m_IndexCount);
+        }
+    );
+
+    commandBuffer.EndScope(profiler);
+
+    if(postPass)
+        postPass(commandBuffer);
+
+    commandBuffer.EndScope(profiler);
+
+    commandBuffer.End();
+}
+
+void TriangleRenderer::EndFrame(uint64_t timelineValue)
+{
+    m_FrameRing->EndFrame(timelineValue);
+}
+
+void TriangleRenderer::LogStats() const
+{
+    m_FrameRing->GetUploadRing().LogStats();
+    m_PipelineLibrary->LogStats();
+    m_PipelineCompiler->LogStats();
+    m_FrameRing->GetCommandRecorder().LogStats();
+    m_GpuProfiler->LogStats();
+}
+
+void TriangleRenderer::CreateRenderPass(const TriangleRendererCreateInfo& createInfo)
+{
+    VulkanAttachmentDescription colorAttachment(
+        createInfo.ColorFormat,
+        VK_SAMPLE_COUNT_1_BIT,
+        VK_ATTACHMENT_LOAD_OP_CLEAR,
+        VK_ATTACHMENT_STORE_OP_STORE,
+        VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+        VK_ATTACHMENT_STORE_OP_DONT_CARE,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+        createInfo.FinalLayout
+    );
+
+    std::shared_ptr<VulkanAttachmentReference> colorAttachmentReference = VulkanAttachmentReference::Create(0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    
+    VulkanSubpassDescription subpass(
+        colorAttachmentReference
+    );
+
+    VulkanSubpassDependency subpassDependency(
+        VK_SUBPASS_EXTERNAL,
+        0,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        0,
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        0
+    );
+    
+    m_RenderPass = VulkanRenderPass::Create(m_Device, colorAttachment, subpass, subpassDependency);
+}
+
+void TriangleRenderer::CreatePipeline(const TriangleRendererCreateInfo& createInfo)
+{
+    // Load shaders
+    std::vector<char> vertexShaderCode = ReadFile(createInfo.ShaderDirectory + "/vert.spv");
+    std::vector<char> fragmentShaderCode = ReadFile(createInfo.ShaderDirectory + "/frag.spv");
+
+    m_VertexShaderModule = std::make_shared<VulkanShaderModule>(m_Device, vertexShaderCode);
+    m_FragmentShaderModule = std::make_shared<VulkanShaderModule>(m_Device, fragmentShaderCode);
+
+    VulkanPipelineShaderStage vertexShaderStage(
+        VK_SHADER_STAGE_VERTEX_BIT,
+        *m_VertexShaderModule
+    );
+
+    VulkanPipelineShaderStage fragmentShaderStage(
+        VK_SHADER_STAGE_FRAGMENT_BIT,
+        *m_FragmentShaderModule
+    );
+
+    std::vector<VulkanPipelineShaderStage> shaderStages({vertexShaderStage, fragmentShaderStage});
+
+    VulkanPipelineDynamicState dynamicStates({VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR});
+
+    std::vector<VulkanVertexInputBindingDescription> vertexBindings = {
+        VulkanVertexInputBindingDescription(0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX),
+        VulkanVertexInputBindingDescription(1, sizeof(glm::vec2), VK_VERTEX_INPUT_RATE_INSTANCE)
+    };
+
+    std::vector<VulkanVertexInputAttributeDescription> vertexAttributes = {
+        VulkanVertexInputAttributeDescription(0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, Position)),
+        VulkanVertexInputAttributeDescription(1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, Color)),
+        VulkanVertexInputAttributeDescription(2, 1, VK_FORMAT_R32G32_SFLOAT, 0)
+    };
+
+    VulkanPipelineVertexInputState vertexInput(vertexBindings, vertexAttributes);
+
+    VulkanPipelineInputAssemblyState inputAssembly(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_FALSE);
+
+    // Viewport and scissor are dynamic, these only fill in the static state
+    VulkanViewport viewport(0, 0, 1.0f, 1.0f, 0, 1.0f);
+
+    VulkanRect2D scissor(VkExtent2D { 1, 1 });
+
+    VulkanPipelineViewportState viewportstate(viewport, scissor);
+
+    VulkanPipelineRasterizationState rasterizationState(
+        VK_POLYGON_MODE_FILL,
+        VK_CULL_MODE_BACK_BIT,
+        false,
+        false,
+        VK_FRONT_FACE_CLOCKWISE,
+        false,
+        1.0f     
+    );
+    
+    VulkanPipelineMultisampleState multisample(1, false);
+
+    VulkanPipelineColorBlendAttachment colorBlendAttachment(
+        true,
+        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+        VK_BLEND_FACTOR_SRC_ALPHA,
+        VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+        VK_BLEND_OP_ADD,
+        VK_BLEND_FACTOR_ONE,
+        VK_BLEND_FACTOR_ZERO,
+        VK_BLEND_OP_ADD
+    );
+
+    std::vector<VulkanPipelineColorBlendAttachment> colorblendAttachments = {colorBlendAttachment};
+
+    VulkanPipelineColorBlendState colorBlendState(
+        false,
+        VK_LOGIC_OP_COPY,
+        colorblendAttachments
+    );
+
+    VulkanPipelineDepthStencilState depthStencilState(
+        true,
+        true,
+        VK_COMPARE_OP_LESS,
+        false,
+        false
+    );
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo {};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 0; // These are optional
+    pipelineLayoutInfo.pSetLayouts = nullptr; // These are optional
+    pipelineLayoutInfo.pushConstantRangeCount = 0; // These are optional
+    pipelineLayoutInfo.pPushConstantRanges = nullptr; // These are optional
+
+    m_PipelineLayout = VulkanPipelineLayout::Create(m_Device, pipelineLayoutInfo);
+
+    m_PipelineLibrary = std::make_unique<VulkanPipelineLibrary>(m_Device);
+
+    m_PipelineCompiler = std::make_unique<VulkanPipelineCompiler>(*m_PipelineLibrary);
+
+    VulkanGraphicsPipelineDescription pipelineDescription
+    {
+        shaderStages,
+        vertexInput,
+        inputAssembly,
+        viewportstate,
+        rasterizationState,
+        multisample,
+        depthStencilState,
+        colorBlendState,
+        dynamicStates,
+        m_PipelineLayout,
+        m_RenderPass,
+        0,
+        { m_VertexShaderModule, m_FragmentShaderModule }
+    };
+
+    // Frames are drawn without the quad until the pipeline is ready
+    m_GraphicsPipeline = m_PipelineCompiler->Compile(pipelineDescription);
+}
+
+void TriangleRenderer::CreateGeometry(const TriangleRendererCreateInfo& createInfo, std::shared_ptr<VulkanQueue> transferQueue)
+{
+    m_CommandPool = std::make_shared<VulkanCommandPool>
+    (
+        m_Device,
+        m_GraphicsQueue->GetFamilyIndex(),
+        VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+    );
+
+    // The quad is split into a grid of cells, two triangles each. Two triangles is the original quad
+    const uint32_t triangleCount = std::max(createInfo.TrianglesPerDraw, 1u);
+    const uint32_t cellCount = (triangleCount + 1) / 2;
+    const uint32_t columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(cellCount))));
+    const uint32_t rows = (cellCount + columns - 1) / columns;
+
+    // Corner colors of the quad, blended across the cells
+    const glm::vec3 corners[4] = {
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 1.0f, 1.0f}
+    };
+
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    vertices.reserve(cellCount * 4);
+    indices.reserve(triangleCount * 3);
+
+    for(uint32_t cell = 0; cell < cellCount; cell++)
+    {
+        const uint32_t column = cell % columns;
+        const uint32_t row = cell / columns;
+        const uint32_t first = static_cast<uint32_t>(vertices.size());
+
+        const float u[2] = { static_cast<float>(column) / columns, static_cast<float>(column + 1) / columns };
+        const float v[2] = { static_cast<float>(row) / rows, static_cast<float>(row + 1) / rows };
+
+        for(auto [x, y] : { std::pair(0, 0), std::pair(1, 0), std::pair(1, 1), std::pair(0, 1) })
+        {
+            glm::vec3 bottom = corners[0] * (1.0f - u[x]) + corners[1] * u[x];
+            glm::vec3 top = corners[3] * (1.0f - u[x]) + corners[2] * u[x];
+
+            vertices.push_back({ { u[x] - 0.5f, v[y] - 0.5f }, bottom * (1.0f - v[y]) + top * v[y] });
+        }
+
+        indices.insert(indices.end(), { first, first + 1, first + 2 });
+
+        if(cell * 2 + 1 < triangleCount)
+            indices.insert(indices.end(), { first + 2, first + 3, first });
+    }
+
+    m_IndexCount = static_cast<uint32_t>(indices.size());
+    m_IndexType = vertices.size() > UINT16_MAX ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
+
+    // Small meshes keep 16 bit indices, they're half the bandwidth
+    std::vector<uint16_t> shortIndices;
+    if(m_IndexType == VK_INDEX_TYPE_UINT16)
+        shortIndices.assign(indices.begin(), indices.end());
+
+    const void* indexData = m_IndexType == VK_INDEX_TYPE_UINT16 ? static_cast<const void*>(shortIndices.data()) : indices.data();
+    const VkDeviceSize indexDataSize = m_IndexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) * shortIndices.size() : sizeof(uint32_t) * indices.size();
+
+    std::shared_ptr<VulkanQueue> uploadQueue = transferQueue ? transferQueue : m_GraphicsQueue;
+    std::shared_ptr<VulkanCommandPool> uploadPool = transferQueue
+        ? std::make_shared<VulkanCommandPool>(m_Device, transferQueue->GetFamilyIndex(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT)
+        : m_CommandPool;
+
+    m_VertexBuffer = VulkanBuffer::CreateDeviceLocal(
+        m_Device,
+        uploadPool,
+        *uploadQueue,
+        m_CommandPool,
+        *m_GraphicsQueue,
+        vertices.data(),
+        sizeof(Vertex) * vertices.size(),
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+    );
+
+    m_IndexBuffer = VulkanBuffer::CreateDeviceLocal(
+        m_Device,
+        uploadPool,
+        *uploadQueue,
+        m_CommandPool,
+        *m_GraphicsQueue,
+        indexData,
+        indexDataSize,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT
+    );
+}
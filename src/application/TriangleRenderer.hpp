@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Vulkan/VulkanDevice.hpp"
+#include "Vulkan/VulkanQueue.hpp"
+#include "Vulkan/VulkanRenderPass.hpp"
+#include "Vulkan/VulkanShaderModule.hpp"
+#include "Vulkan/VulkanPipelineLayout.hpp"
+#include "Vulkan/VulkanPipelineLibrary.hpp"
+#include "Vulkan/VulkanPipelineCompiler.hpp"
+#include "Vulkan/VulkanCommandPool.hpp"
+#include "Vulkan/VulkanCommandBuffer.hpp"
+#include "Vulkan/VulkanBuffer.hpp"
+#include "Vulkan/VulkanFrameContext.hpp"
+#include "Vulkan/VulkanGpuProfiler.hpp"
+
+#include <functional>
+#include <string>
+
+struct TriangleRendererCreateInfo
+{
+    VkFormat ColorFormat = VK_FORMAT_B8G8R8A8_SRGB;
+
+    // Layout the color attachment is left in. Swapchain images want VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+    // offscreen targets that get read back VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+    VkImageLayout FinalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    // How far the CPU may run ahead of the GPU
+    uint32_t FramesInFlight = 2;
+
+    // Draws recorded per frame, each one draws the whole mesh
+    uint32_t DrawCount = 1;
+
+    // Size of the mesh. Rounded up to whole quads, but only this many get drawn
+    uint32_t TrianglesPerDraw = 2;
+
+    std::string ShaderDirectory = "shaders";
+};
+
+// Recorded into the frame's command buffer after the render pass has ended
+using TriangleRendererPostPass = std::function<void(VulkanCommandBuffer& commandBuffer)>;
+
+// The scene itself: render pass, pipeline, geometry and the per frame resources. It doesn't know where
+// frames end up, so the same code renders into swapchain images and into offscreen targets
+class TriangleRenderer
+{
+public:
+    // |transferQueue| may be nullptr, uploads go through |graphicsQueue| then
+    TriangleRenderer(
+        std::shared_ptr<VulkanDevice> device,
+        std::shared_ptr<VulkanQueue> graphicsQueue,
+        std::shared_ptr<VulkanQueue> transferQueue,
+        const TriangleRendererCreateInfo& createInfo
+    );
+
+    ~TriangleRenderer();
+
+    TriangleRenderer(const TriangleRenderer&) = delete;
+    TriangleRenderer& operator=(const TriangleRenderer&) = delete;
+
+    // Waits until the oldest frame context has retired and hands it out again
+    VulkanFrameContext& BeginFrame();
+
+    // Records the scene at |time| seconds into the frame's command buffer, targeting |framebuffer|
+    void RecordFrame(VulkanFrameContext& frame, const VulkanFramebuffer& framebuffer, float time, const TriangleRendererPostPass& postPass = nullptr);
+
+    // |timelineValue| is what submitting the frame's command buffer returned
+    void EndFrame(uint64_t timelineValue);
+
+    std::shared_ptr<VulkanRenderPass> GetRenderPass() const { return m_RenderPass; }
+    std::shared_ptr<VulkanQueue> GetGraphicsQueue() const { return m_GraphicsQueue; }
+
+    VulkanFrameContextRing& GetFrameContextRing() { return *m_FrameRing; }
+    VulkanGpuProfiler& GetGpuProfiler() { return *m_GpuProfiler; }
+
+    void LogStats() const;
+
+private:
+    void CreateRenderPass(const TriangleRendererCreateInfo& createInfo);
+    void CreatePipeline(const TriangleRendererCreateInfo& createInfo);
+    void CreateGeometry(const TriangleRendererCreateInfo& createInfo, std::shared_ptr<VulkanQueue> transferQueue);
+
+private:
+    std::shared_ptr<VulkanDevice> m_Device;
+    std::shared_ptr<VulkanQueue> m_GraphicsQueue;
+
+    std::shared_ptr<VulkanRenderPass> m_RenderPass;
+
+    // Referenced by pipelines still compiling, so they have to outlive the compiler
+    std::shared_ptr<VulkanShaderModule> m_VertexShaderModule;
+    std::shared_ptr<VulkanShaderModule> m_FragmentShaderModule;
+
+    std::shared_ptr<VulkanPipelineLayout> m_PipelineLayout;
+    std::unique_ptr<VulkanPipelineLibrary> m_PipelineLibrary;
+    std::unique_ptr<VulkanPipelineCompiler> m_PipelineCompiler;
+    VulkanPipelineCompileHandle m_GraphicsPipeline;
+
+    std::shared_ptr<VulkanCommandPool> m_CommandPool;
+
+    std::shared_ptr<VulkanBuffer> m_VertexBuffer;
+    std::shared_ptr<VulkanBuffer> m_IndexBuffer;
+    uint32_t m_IndexCount;
+    VkIndexType m_IndexType;
+
+    uint32_t m_DrawCount;
+
+    // Command buffers, acquire semaphores and transient allocations of each frame in flight
+    std::unique_ptr<VulkanFrameContextRing> m_FrameRing;
+
+    // Timings of a frame are read back when its context comes around again
+    std::unique_ptr<VulkanGpuProfiler> m_GpuProfiler;
+};
@@ -2,61 +2,48 @@
 
 #include "../debug/Log.hpp"
 #include "VulkanInstance.hpp"
+#include "VulkanValidationAggregator.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 #include <vulkan/vulkan.hpp>
 
 #include <functional>
+#include <memory>
 
 #define FETCH_VK_FUNCTION(instance, function) \
     reinterpret_cast<PFN_##function>(vkGetInstanceProcAddr(instance, #function))
 
-static VKAPI_ATTR VkBool32 VKAPI_CALL DefaultCallback(
-    VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
-    VkDebugUtilsMessageTypeFlagsEXT messageType, 
-    const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
-    void* pUserData)
-{
-    const char* msg = "Vulkan validation layer: ";
-
-    switch(messageSeverity)
-    {
-        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
-            Log.Error(msg, pCallbackData->pMessage);
-        break;
-        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
-            Log.Warn(msg, pCallbackData->pMessage);
-        break;
-        default: // VERBOSE & INFO
-            Log.Info(msg, pCallbackData->pMessage);
-    }
-
-    return VK_FALSE;
-}
-
 class DebugUtilsMessenger
 {
 public:
     DebugUtilsMessenger() = delete;
 
+    // Without |fn| messages go through a VulkanValidationAggregator, which dedupes and rate limits them
     DebugUtilsMessenger(
         std::shared_ptr<VulkanInstance> instance,
-        PFN_vkDebugUtilsMessengerCallbackEXT fn
+        PFN_vkDebugUtilsMessengerCallbackEXT fn = nullptr,
+        const VulkanValidationAggregatorCreateInfo& aggregatorInfo = {}
     )
         : m_Instance(instance), m_DebugMessenger {}
     {
+        void* userData = nullptr;
+
         if(fn == nullptr)
         {
-            Log.Info("DebugUtils - ", "No callback function provided using default callback");
-            fn = DefaultCallback;
+            m_Aggregator = std::make_unique<VulkanValidationAggregator>(aggregatorInfo);
+
+            fn = VulkanValidationAggregator::Callback;
+            userData = m_Aggregator.get();
         }
 
         VkDebugUtilsMessengerCreateInfoEXT createInfo {};
 
         createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
-        createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        // Verbose is loader and layer chatter, thousands of lines a second with nothing about our code
+        createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
         createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
         createInfo.pfnUserCallback = fn;
-        createInfo.pUserData = nullptr;
+        createInfo.pUserData = userData;
 
         auto CreateDebugUtilsMessengerEXT = FETCH_VK_FUNCTION(instance->GetInstance(), vkCreateDebugUtilsMessengerEXT);
         
@@ -75,8 +62,6 @@ public:
             Log.Warn("Failed to properly initialize DebugUtilsMessenger");
             // throw std::runtime_error("Failed to create debug messenger");
         }
-
-        Log.Info("Created VulkanDebugMessenger");
     }
 
     ~DebugUtilsMessenger()
@@ -85,7 +70,6 @@ public:
 
         if(DestroyDebugUtilsMessengerEXT)
         {
-            Log.Info("Destructed VulkanDebugMessenger");
             DestroyDebugUtilsMessengerEXT(m_Instance->GetInstance(), m_DebugMessenger, nullptr);
         }
         else
@@ -93,10 +77,21 @@ public:
             Log.Warn("Failed to fetch vkDestroyDebugUtilsMessengerEXT");
             Log.Error("Failed to destroy VkDebugUtilsMessenger");
         }
+
+        // No more messages come in, get the last counts out
+        if(m_Aggregator)
+            m_Aggregator->Flush();
     }
-    
+
+    // nullptr when a custom callback was given
+    VulkanValidationAggregator* GetAggregator() const { return m_Aggregator.get(); }
 
 private:
     std::shared_ptr<VulkanInstance> m_Instance;
     VkDebugUtilsMessengerEXT m_DebugMessenger;
+
+    // Outlives the messenger, the layer may call back until the messenger is destroyed
+    std::unique_ptr<VulkanValidationAggregator> m_Aggregator;
+
+    VulkanObjectTracker<VulkanObjectType::DebugMessenger> m_Tracker;
 };
\ No newline at end of file
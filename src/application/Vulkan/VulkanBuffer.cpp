@@ -0,0 +1,273 @@
+#include "VulkanBuffer.hpp"
+
+#include "VulkanCommandPool.hpp"
+#include "VulkanCommandBuffer.hpp"
+#include "VulkanFence.hpp"
+#include "VulkanQueue.hpp"
+
+#include <cstring>
+
+VulkanBuffer::VulkanBuffer
+(
+    std::shared_ptr<VulkanDevice> device,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkMemoryPropertyFlags requiredMemoryFlags,
+    VkMemoryPropertyFlags preferredMemoryFlags,
+    VkSharingMode sharingMode,
+    const std::vector<uint32_t>& queueFamilyIndices
+) : m_Device(device), m_Buffer(VK_NULL_HANDLE), m_Size(size), m_Usage(usage)
+{
+    VkBufferCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = size;
+    createInfo.usage = usage;
+    createInfo.sharingMode = sharingMode;
+    createInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilyIndices.size());
+    createInfo.pQueueFamilyIndices = queueFamilyIndices.data();
+
+    VkResult result = vkCreateBuffer(device->GetHandle(), &createInfo, nullptr, &m_Buffer);
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error("vkCreateBuffer failed");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    VulkanAllocationCreateInfo allocationInfo;
+    allocationInfo.RequiredFlags = requiredMemoryFlags;
+    allocationInfo.PreferredFlags = preferredMemoryFlags;
+    allocationInfo.Linear = true;
+
+    try
+    {
+        m_Allocation = device->GetAllocator().AllocateForBuffer(m_Buffer, allocationInfo);
+        result = vkBindBufferMemory(device->GetHandle(), m_Buffer, m_Allocation.Memory, m_Allocation.Offset);
+    }
+    catch(...)
+    {
+        vkDestroyBuffer(device->GetHandle(), m_Buffer, nullptr);
+        throw;
+    }
+
+    if(result != VK_SUCCESS)
+    {
+        vkDestroyBuffer(device->GetHandle(), m_Buffer, nullptr);
+        device->GetAllocator().Free(m_Allocation);
+
+        Log.Error("vkBindBufferMemory failed");
+        throw std::runtime_error("Vulkan error");
+    }
+}
+
+VulkanBuffer::~VulkanBuffer()
+{
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), buffer = m_Buffer, allocation = m_Allocation, &allocator = m_Device->GetAllocator()]() mutable
+    {
+        vkDestroyBuffer(device, buffer, nullptr);
+        allocator.Free(allocation);
+    });
+}
+
+std::shared_ptr<VulkanBuffer> VulkanBuffer::Create
+(
+    std::shared_ptr<VulkanDevice> device,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkMemoryPropertyFlags requiredMemoryFlags,
+    VkMemoryPropertyFlags preferredMemoryFlags,
+    VkSharingMode sharingMode,
+    const std::vector<uint32_t>& queueFamilyIndices
+)
+{
+    return std::make_shared<VulkanBuffer>(device, size, usage, requiredMemoryFlags, preferredMemoryFlags, sharingMode, queueFamilyIndices);
+}
+
+// Stages and accesses a buffer with |usage| may be read by once it has been uploaded
+static void GetReadStages(VkBufferUsageFlags usage, VkPipelineStageFlags& stages, VkAccessFlags& access)
+{
+    if(usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+    {
+        stages |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        access |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+    }
+
+    if(usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+    {
+        stages |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        access |= VK_ACCESS_INDEX_READ_BIT;
+    }
+
+    if(stages == 0)
+    {
+        stages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        access = VK_ACCESS_MEMORY_READ_BIT;
+    }
+}
+
+std::shared_ptr<VulkanBuffer> VulkanBuffer::CreateDeviceLocal
+(
+    std::shared_ptr<VulkanDevice> device,
+    std::shared_ptr<VulkanCommandPool> commandPool,
+    VulkanQueue& queue,
+    const void* data,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage
+)
+{
+    VulkanBuffer stagingBuffer(
+        device,
+        size,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    );
+
+    stagingBuffer.Write(data, size);
+
+    std::shared_ptr<VulkanBuffer> buffer = Create(
+        device,
+        size,
+        usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+    );
+
+    // Make the copy visible to every stage that may read the buffer later on
+    VkPipelineStageFlags destinationStage = 0;
+    VkAccessFlags destinationAccess = 0;
+    GetReadStages(usage, destinationStage, destinationAccess);
+
+    std::unique_ptr<VulkanCommandBuffer> commandBuffer = commandPool->CreatePrimaryBuffer();
+
+    commandBuffer->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    commandBuffer->CopyBuffer(stagingBuffer, *buffer, size);
+    commandBuffer->BufferBarrier(
+        *buffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        destinationStage,
+        destinationAccess
+    );
+    commandBuffer->End();
+
+    VulkanFence uploadFence(device);
+    queue.Submit(*commandBuffer, 0, nullptr, nullptr, &uploadFence);
+    uploadFence.Wait();
+
+    commandPool->DestroyCommandBuffer(std::move(commandBuffer));
+
+    return buffer;
+}
+
+std::shared_ptr<VulkanBuffer> VulkanBuffer::CreateDeviceLocal
+(
+    std::shared_ptr<VulkanDevice> device,
+    std::shared_ptr<VulkanCommandPool> transferPool,
+    VulkanQueue& transferQueue,
+    std::shared_ptr<VulkanCommandPool> ownerPool,
+    VulkanQueue& ownerQueue,
+    const void* data,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage
+)
+{
+    uint32_t transferFamily = transferQueue.GetFamilyIndex();
+    uint32_t ownerFamily = ownerQueue.GetFamilyIndex();
+
+    if(transferFamily == ownerFamily)
+        return CreateDeviceLocal(device, transferPool, transferQueue, data, size, usage);
+
+    VulkanBuffer stagingBuffer(
+        device,
+        size,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    );
+
+    stagingBuffer.Write(data, size);
+
+    std::shared_ptr<VulkanBuffer> buffer = Create(
+        device,
+        size,
+        usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+    );
+
+    VkPipelineStageFlags destinationStage = 0;
+    VkAccessFlags destinationAccess = 0;
+    GetReadStages(usage, destinationStage, destinationAccess);
+
+    std::unique_ptr<VulkanCommandBuffer> copyCommands = transferPool->CreatePrimaryBuffer();
+
+    copyCommands->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    copyCommands->CopyBuffer(stagingBuffer, *buffer, size);
+    copyCommands->ReleaseBufferOwnership(*buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, transferFamily, ownerFamily);
+    copyCommands->End();
+
+    std::unique_ptr<VulkanCommandBuffer> acquireCommands = ownerPool->CreatePrimaryBuffer();
+
+    acquireCommands->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    acquireCommands->AcquireBufferOwnership(*buffer, destinationStage, destinationAccess, transferFamily, ownerFamily);
+    acquireCommands->End();
+
+    uint64_t copyValue = transferQueue.SubmitTimeline(*copyCommands);
+
+    // The acquire has to execute after the release, the transfer queue's timeline orders them
+    VulkanQueueWait copyFinished { &transferQueue, copyValue, destinationStage };
+    uint64_t acquireValue = ownerQueue.SubmitTimeline(*acquireCommands, 0, nullptr, nullptr, { copyFinished });
+
+    ownerQueue.WaitForValue(acquireValue);
+
+    transferPool->DestroyCommandBuffer(std::move(copyCommands));
+    ownerPool->DestroyCommandBuffer(std::move(acquireCommands));
+
+    return buffer;
+}
+
+void VulkanBuffer::Write(const void* data, VkDeviceSize size, VkDeviceSize offset)
+{
+    if(m_Allocation.MappedData == nullptr)
+    {
+        Log.Error("Tried to write to a buffer which isn't host visible");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    std::memcpy(static_cast<char*>(m_Allocation.MappedData) + offset, data, size);
+    Flush(offset, size);
+}
+
+void VulkanBuffer::Flush(VkDeviceSize offset, VkDeviceSize size)
+{
+    m_Device->GetAllocator().Flush(m_Allocation, offset, size);
+}
+
+VkBuffer VulkanBuffer::GetHandle() const
+{
+    return m_Buffer;
+}
+
+VkDeviceSize VulkanBuffer::GetSize() const
+{
+    return m_Size;
+}
+
+VkBufferUsageFlags VulkanBuffer::GetUsage() const
+{
+    return m_Usage;
+}
+
+void* VulkanBuffer::GetMappedData() const
+{
+    return m_Allocation.MappedData;
+}
+
+const VulkanAllocation& VulkanBuffer::GetAllocation() const
+{
+    return m_Allocation;
+}
+
+std::shared_ptr<VulkanDevice> VulkanBuffer::GetDevice() const
+{
+    return m_Device;
+}
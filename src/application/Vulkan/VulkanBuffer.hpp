@@ -0,0 +1,85 @@
+#pragma once
+
+#include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+class VulkanCommandPool;
+class VulkanQueue;
+
+class VulkanBuffer
+{
+public:
+    VulkanBuffer(
+        std::shared_ptr<VulkanDevice> device,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        VkMemoryPropertyFlags requiredMemoryFlags,
+        VkMemoryPropertyFlags preferredMemoryFlags = 0,
+        VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        const std::vector<uint32_t>& queueFamilyIndices = {}
+    );
+
+    ~VulkanBuffer();
+
+    VulkanBuffer(const VulkanBuffer&) = delete;
+    VulkanBuffer& operator=(const VulkanBuffer&) = delete;
+
+    static std::shared_ptr<VulkanBuffer> Create(
+        std::shared_ptr<VulkanDevice> device,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        VkMemoryPropertyFlags requiredMemoryFlags,
+        VkMemoryPropertyFlags preferredMemoryFlags = 0,
+        VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        const std::vector<uint32_t>& queueFamilyIndices = {}
+    );
+
+    // Uploads |data| through a temporary staging buffer into a new device local buffer.
+    // Blocks until the copy has finished so it's meant for load time, not for per frame data
+    static std::shared_ptr<VulkanBuffer> CreateDeviceLocal(
+        std::shared_ptr<VulkanDevice> device,
+        std::shared_ptr<VulkanCommandPool> commandPool,
+        VulkanQueue& queue,
+        const void* data,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage
+    );
+
+    // Same, but the copy runs on |transferQueue|, typically a dedicated one, and the buffer is then handed over
+    // to |ownerQueue|'s family. |transferPool| and |ownerPool| have to belong to the respective queue families.
+    // Falls back to the single queue upload when both queues share a family
+    static std::shared_ptr<VulkanBuffer> CreateDeviceLocal(
+        std::shared_ptr<VulkanDevice> device,
+        std::shared_ptr<VulkanCommandPool> transferPool,
+        VulkanQueue& transferQueue,
+        std::shared_ptr<VulkanCommandPool> ownerPool,
+        VulkanQueue& ownerQueue,
+        const void* data,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage
+    );
+
+    // Copies |size| bytes into the mapped memory and flushes when the memory isn't coherent
+    void Write(const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
+    void Flush(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+    VkBuffer GetHandle() const;
+    VkDeviceSize GetSize() const;
+    VkBufferUsageFlags GetUsage() const;
+    
+    // nullptr if the buffer isn't host visible
+    void* GetMappedData() const;
+
+    const VulkanAllocation& GetAllocation() const;
+    std::shared_ptr<VulkanDevice> GetDevice() const;
+
+private:
+    std::shared_ptr<VulkanDevice> m_Device;
+    VkBuffer m_Buffer;
+    VkDeviceSize m_Size;
+    VkBufferUsageFlags m_Usage;
+
+    VulkanAllocation m_Allocation;
+
+    VulkanObjectTracker<VulkanObjectType::Buffer> m_Tracker;
+};
@@ -1,14 +1,13 @@
 #include "VulkanCommandBuffer.hpp"
+#include "VulkanGpuProfiler.hpp"
 
-VulkanCommandBuffer::VulkanCommandBuffer(std::shared_ptr<VulkanCommandPool> commandPool, VkCommandBuffer handle)
-    : m_CommandPool(commandPool), m_CommandBuffer(handle)
+VulkanCommandBuffer::VulkanCommandBuffer(std::shared_ptr<VulkanCommandPool> commandPool, VkCommandBuffer handle, VkCommandBufferLevel level)
+    : m_CommandPool(commandPool), m_CommandBuffer(handle), m_Level(level)
 {
-    Log.Info("VulkanCommandBuffer instantiated");
 }
 
 VulkanCommandBuffer::~VulkanCommandBuffer()
 {
-    Log.Info("VulkanCommandBuffer retired");
 }
 
 VkCommandBuffer VulkanCommandBuffer::GetHandle() const
@@ -28,6 +27,30 @@ bool VulkanCommandBuffer::Begin(VkCommandBufferUsageFlags flags)
     return commandBeginInfoResult == VK_SUCCESS;
 }
 
+bool VulkanCommandBuffer::BeginSecondary
+(
+    const VulkanRenderPass& renderPass,
+    uint32_t subpass,
+    const VulkanFramebuffer* framebuffer,
+    VkCommandBufferUsageFlags flags
+)
+{
+    VkCommandBufferInheritanceInfo inheritanceInfo {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = renderPass.GetHandle();
+    inheritanceInfo.subpass = subpass;
+    inheritanceInfo.framebuffer = framebuffer ? framebuffer->GetHandle() : VK_NULL_HANDLE;
+
+    VkCommandBufferBeginInfo beginInfo {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = flags | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    VkResult result = vkBeginCommandBuffer(m_CommandBuffer, &beginInfo);
+
+    return result == VK_SUCCESS;
+}
+
 void VulkanCommandBuffer::End()
 {
     VkResult result = vkEndCommandBuffer(m_CommandBuffer);
@@ -94,4 +117,177 @@ void VulkanCommandBuffer::SetScissor(const VulkanRect2D& scissor)
 void VulkanCommandBuffer::Draw(uint32_t vertexCount, uint32_t firstVertex)
 {
     vkCmdDraw(m_CommandBuffer, vertexCount, 1, firstVertex, 0);
+}
+
+void VulkanCommandBuffer::DrawIndexed(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)
+{
+    vkCmdDrawIndexed(m_CommandBuffer, indexCount, 1, firstIndex, vertexOffset, 0);
+}
+
+void VulkanCommandBuffer::BindVertexBuffers(uint32_t firstBinding, const std::vector<const VulkanBuffer*>& buffers, const std::vector<VkDeviceSize>& offsets)
+{
+    std::vector<VkBuffer> handles;
+    handles.reserve(buffers.size());
+
+    for(const VulkanBuffer* buffer : buffers)
+        handles.push_back(buffer->GetHandle());
+
+    // Missing offsets default to the start of each buffer
+    std::vector<VkDeviceSize> bindOffsets(offsets);
+    bindOffsets.resize(buffers.size(), 0);
+
+    vkCmdBindVertexBuffers(m_CommandBuffer, firstBinding, static_cast<uint32_t>(handles.size()), handles.data(), bindOffsets.data());
+}
+
+void VulkanCommandBuffer::BindIndexBuffer(const VulkanBuffer& buffer, VkIndexType indexType, VkDeviceSize offset)
+{
+    vkCmdBindIndexBuffer(m_CommandBuffer, buffer.GetHandle(), offset, indexType);
+}
+
+void VulkanCommandBuffer::ExecuteCommands(const std::vector<const VulkanCommandBuffer*>& commandBuffers)
+{
+    std::vector<VkCommandBuffer> handles;
+    handles.reserve(commandBuffers.size());
+
+    for(const VulkanCommandBuffer* commandBuffer : commandBuffers)
+        handles.push_back(commandBuffer->GetHandle());
+
+    if(handles.empty())
+        return;
+
+    vkCmdExecuteCommands(m_CommandBuffer, static_cast<uint32_t>(handles.size()), handles.data());
+}
+
+void VulkanCommandBuffer::CopyBuffer
+(
+    const VulkanBuffer& source,
+    const VulkanBuffer& destination,
+    VkDeviceSize size,
+    VkDeviceSize sourceOffset,
+    VkDeviceSize destinationOffset
+)
+{
+    VkBufferCopy region {};
+    region.srcOffset = sourceOffset;
+    region.dstOffset = destinationOffset;
+    region.size = size;
+
+    vkCmdCopyBuffer(m_CommandBuffer, source.GetHandle(), destination.GetHandle(), 1, &region);
+}
+
+void VulkanCommandBuffer::CopyImageToBuffer(const VulkanImage& image, VkImageLayout imageLayout, const VulkanBuffer& destination, VkDeviceSize destinationOffset)
+{
+    VkExtent2D extent = image.GetExtent();
+
+    VkBufferImageCopy region {};
+    region.bufferOffset = destinationOffset;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = { 0, 0, 0 };
+    region.imageExtent = { extent.width, extent.height, 1 };
+
+    vkCmdCopyImageToBuffer(m_CommandBuffer, image.GetHandle(), imageLayout, destination.GetHandle(), 1, &region);
+}
+
+void VulkanCommandBuffer::ImageBarrier
+(
+    const VulkanImage& image,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    VkPipelineStageFlags sourceStage,
+    VkAccessFlags sourceAccess,
+    VkPipelineStageFlags destinationStage,
+    VkAccessFlags destinationAccess
+)
+{
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = sourceAccess;
+    barrier.dstAccessMask = destinationAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image.GetHandle();
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier(m_CommandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void VulkanCommandBuffer::BufferBarrier
+(
+    const VulkanBuffer& buffer,
+    VkPipelineStageFlags sourceStage,
+    VkAccessFlags sourceAccess,
+    VkPipelineStageFlags destinationStage,
+    VkAccessFlags destinationAccess,
+    uint32_t sourceFamilyIndex,
+    uint32_t destinationFamilyIndex
+)
+{
+    VkBufferMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = sourceAccess;
+    barrier.dstAccessMask = destinationAccess;
+    barrier.srcQueueFamilyIndex = sourceFamilyIndex;
+    barrier.dstQueueFamilyIndex = destinationFamilyIndex;
+    barrier.buffer = buffer.GetHandle();
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(m_CommandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+void VulkanCommandBuffer::ReleaseBufferOwnership
+(
+    const VulkanBuffer& buffer,
+    VkPipelineStageFlags sourceStage,
+    VkAccessFlags sourceAccess,
+    uint32_t sourceFamilyIndex,
+    uint32_t destinationFamilyIndex
+)
+{
+    // Destination access is ignored by a release, visibility is up to the acquire
+    BufferBarrier(buffer, sourceStage, sourceAccess, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, sourceFamilyIndex, destinationFamilyIndex);
+}
+
+void VulkanCommandBuffer::AcquireBufferOwnership
+(
+    const VulkanBuffer& buffer,
+    VkPipelineStageFlags destinationStage,
+    VkAccessFlags destinationAccess,
+    uint32_t sourceFamilyIndex,
+    uint32_t destinationFamilyIndex
+)
+{
+    // Source access is ignored by an acquire, the semaphore wait covers availability
+    BufferBarrier(buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, destinationStage, destinationAccess, sourceFamilyIndex, destinationFamilyIndex);
+}
+
+void VulkanCommandBuffer::ResetQueryPool(const VulkanQueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount)
+{
+    vkCmdResetQueryPool(m_CommandBuffer, queryPool.GetHandle(), firstQuery, queryCount);
+}
+
+void VulkanCommandBuffer::WriteTimestamp(const VulkanQueryPool& queryPool, uint32_t query, VkPipelineStageFlagBits stage)
+{
+    vkCmdWriteTimestamp(m_CommandBuffer, stage, queryPool.GetHandle(), query);
+}
+
+void VulkanCommandBuffer::BeginScope(VulkanGpuProfiler& profiler, const char* name)
+{
+    profiler.BeginScope(*this, name);
+}
+
+void VulkanCommandBuffer::EndScope(VulkanGpuProfiler& profiler)
+{
+    profiler.EndScope(*this);
 }
\ No newline at end of file
@@ -6,17 +6,34 @@
 #include "VulkanRect2D.hpp"
 #include "VulkanViewport.hpp"
 #include "VulkanPipeline.hpp"
+#include "VulkanBuffer.hpp"
+#include "VulkanImage.hpp"
+#include "VulkanQueryPool.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+class VulkanGpuProfiler;
 
 class VulkanCommandBuffer
 {
 public:
-    VulkanCommandBuffer(std::shared_ptr<VulkanCommandPool> commandPool, VkCommandBuffer handle);
+    VulkanCommandBuffer(std::shared_ptr<VulkanCommandPool> commandPool, VkCommandBuffer handle, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
     ~VulkanCommandBuffer();
 
     VkCommandBuffer GetHandle() const;
     const VkCommandBuffer& GetHandleAddress() const { return m_CommandBuffer; }
+    VkCommandBufferLevel GetLevel() const { return m_Level; }
     
     bool Begin(VkCommandBufferUsageFlags flags = 0);
+
+    // Begins a secondary buffer that continues |subpass| of |renderPass|. The framebuffer is optional
+    // but lets the driver specialize the recorded commands for it
+    bool BeginSecondary(
+        const VulkanRenderPass& renderPass,
+        uint32_t subpass,
+        const VulkanFramebuffer* framebuffer,
+        VkCommandBufferUsageFlags flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    );
+
     void End();
     void BindPipeline(const VulkanPipeline& pipeline, VkPipelineBindPoint bindPoint);
 
@@ -35,10 +52,72 @@ public:
     void SetScissor(const VulkanRect2D& scissor);
 
     void Draw(uint32_t vertexCount, uint32_t firstVertex = 0);
+    void DrawIndexed(uint32_t indexCount, uint32_t firstIndex = 0, int32_t vertexOffset = 0);
+
+    void BindVertexBuffers(uint32_t firstBinding, const std::vector<const VulkanBuffer*>& buffers, const std::vector<VkDeviceSize>& offsets = {});
+    void BindIndexBuffer(const VulkanBuffer& buffer, VkIndexType indexType, VkDeviceSize offset = 0);
+
+    // Secondary buffers inside a render pass begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+    void ExecuteCommands(const std::vector<const VulkanCommandBuffer*>& commandBuffers);
+
+    void CopyBuffer(const VulkanBuffer& source, const VulkanBuffer& destination, VkDeviceSize size, VkDeviceSize sourceOffset = 0, VkDeviceSize destinationOffset = 0);
+
+    // Copies the whole first mip level of a color |image| in |imageLayout| into |destination|, tightly packed
+    void CopyImageToBuffer(const VulkanImage& image, VkImageLayout imageLayout, const VulkanBuffer& destination, VkDeviceSize destinationOffset = 0);
+
+    // Covers the whole color image
+    void ImageBarrier(
+        const VulkanImage& image,
+        VkImageLayout oldLayout,
+        VkImageLayout newLayout,
+        VkPipelineStageFlags sourceStage,
+        VkAccessFlags sourceAccess,
+        VkPipelineStageFlags destinationStage,
+        VkAccessFlags destinationAccess
+    );
+
+    void BufferBarrier(
+        const VulkanBuffer& buffer,
+        VkPipelineStageFlags sourceStage,
+        VkAccessFlags sourceAccess,
+        VkPipelineStageFlags destinationStage,
+        VkAccessFlags destinationAccess,
+        uint32_t sourceFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        uint32_t destinationFamilyIndex = VK_QUEUE_FAMILY_IGNORED
+    );
+
+    // Queue family ownership transfer of an exclusive buffer. The release is recorded on the queue giving
+    // the buffer up, the matching acquire on the receiving queue, which must wait for the release's submission
+    void ReleaseBufferOwnership(
+        const VulkanBuffer& buffer,
+        VkPipelineStageFlags sourceStage,
+        VkAccessFlags sourceAccess,
+        uint32_t sourceFamilyIndex,
+        uint32_t destinationFamilyIndex
+    );
+
+    void AcquireBufferOwnership(
+        const VulkanBuffer& buffer,
+        VkPipelineStageFlags destinationStage,
+        VkAccessFlags destinationAccess,
+        uint32_t sourceFamilyIndex,
+        uint32_t destinationFamilyIndex
+    );
+
+    // Queries must be reset before they're written, outside of a render pass
+    void ResetQueryPool(const VulkanQueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount);
+    void WriteTimestamp(const VulkanQueryPool& queryPool, uint32_t query, VkPipelineStageFlagBits stage);
+
+    // Named GPU timer scopes, nest like a stack. Forwarded to |profiler| which owns the queries
+    void BeginScope(VulkanGpuProfiler& profiler, const char* name);
+    void EndScope(VulkanGpuProfiler& profiler);
 
 private:
     friend class VulkanCommandPool;
 
     std::shared_ptr<VulkanCommandPool> m_CommandPool;
     VkCommandBuffer m_CommandBuffer;
+    VkCommandBufferLevel m_Level;
+
+    VulkanObjectTracker<VulkanObjectType::CommandBuffer> m_Tracker;
 };
\ No newline at end of file
@@ -16,14 +16,14 @@ VulkanCommandPool::VulkanCommandPool(std::shared_ptr<VulkanDevice> device, uint3
         Log.Error("Failed to create commandpool");
         throw std::runtime_error("Vulkan error");
     }
-
-    Log.Info("CommandPool created");
 }
 
 VulkanCommandPool::~VulkanCommandPool()
 {
-    vkDestroyCommandPool(m_Device->GetHandle(), m_CommandPool, nullptr);
-    Log.Info("CommandPool destructed");
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), commandPool = m_CommandPool]()
+    {
+        vkDestroyCommandPool(device, commandPool, nullptr);
+    });
 }
 
 VkCommandPool VulkanCommandPool::GetHandle() const
@@ -33,35 +33,34 @@ VkCommandPool VulkanCommandPool::GetHandle() const
 
 std::unique_ptr<VulkanCommandBuffer> VulkanCommandPool::CreatePrimaryBuffer()
 {
-    VkCommandBufferAllocateInfo allocInfo {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool = m_CommandPool;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = 1;
+    std::unique_ptr<VulkanCommandBuffer> commandBuffer = std::move(CreateBuffers(VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1).front());
+    
+    return commandBuffer;   
+}
 
-    VkCommandBuffer bufferHandle = VK_NULL_HANDLE;
+std::vector<std::unique_ptr<VulkanCommandBuffer>> VulkanCommandPool::CreatePrimaryBuffers(uint32_t bufferCount)
+{
+    return CreateBuffers(VK_COMMAND_BUFFER_LEVEL_PRIMARY, bufferCount);
+}
 
-    VkResult result = vkAllocateCommandBuffers(m_Device->GetHandle(), &allocInfo, &bufferHandle);
+std::unique_ptr<VulkanCommandBuffer> VulkanCommandPool::CreateSecondaryBuffer()
+{
+    std::unique_ptr<VulkanCommandBuffer> commandBuffer = std::move(CreateBuffers(VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1).front());
 
-    if(result != VK_SUCCESS)
-    {
-        Log.Error("Failed to create commandbuffer");
-        throw std::runtime_error("Vulkan error");
-    }
+    return commandBuffer;
+}
 
-    Log.Info("Primary CommandBuffer created");
-    
-    std::unique_ptr<VulkanCommandBuffer> commandBuffer = std::make_unique<VulkanCommandBuffer>(shared_from_this(), bufferHandle);
-    
-    return commandBuffer;   
+std::vector<std::unique_ptr<VulkanCommandBuffer>> VulkanCommandPool::CreateSecondaryBuffers(uint32_t bufferCount)
+{
+    return CreateBuffers(VK_COMMAND_BUFFER_LEVEL_SECONDARY, bufferCount);
 }
 
-std::vector<std::unique_ptr<VulkanCommandBuffer>> VulkanCommandPool::CreatePrimaryBuffers(uint32_t bufferCount)
+std::vector<std::unique_ptr<VulkanCommandBuffer>> VulkanCommandPool::CreateBuffers(VkCommandBufferLevel level, uint32_t bufferCount)
 {
     VkCommandBufferAllocateInfo allocInfo {};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.commandPool = m_CommandPool;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.level = level;
     allocInfo.commandBufferCount = bufferCount;
 
     std::vector<VkCommandBuffer> bufferHandles(bufferCount);
@@ -78,18 +77,32 @@ std::vector<std::unique_ptr<VulkanCommandBuffer>> VulkanCommandPool::CreatePrima
 
     for(VkCommandBuffer bufferHandle : bufferHandles)
     {
-        commandBuffers.emplace_back(std::make_unique<VulkanCommandBuffer>(shared_from_this(), bufferHandle));
+        commandBuffers.emplace_back(std::make_unique<VulkanCommandBuffer>(shared_from_this(), bufferHandle, level));
     }
 
     return commandBuffers;
 }
 
+void VulkanCommandPool::Reset(VkCommandPoolResetFlags flags)
+{
+    VkResult result = vkResetCommandPool(m_Device->GetHandle(), m_CommandPool, flags);
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error("CommandPool::Reset failed");
+        throw std::runtime_error("Vulkan error");
+    }
+}
+
 void VulkanCommandPool::DestroyCommandBuffer(std::unique_ptr<VulkanCommandBuffer> commandBuffer)
 {
     VkCommandBuffer handle = commandBuffer->GetHandle();
     commandBuffer->m_CommandBuffer = VK_NULL_HANDLE;
 
-    vkFreeCommandBuffers(m_Device->GetHandle(), m_CommandPool, 1, &handle);
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), commandPool = m_CommandPool, handle]()
+    {
+        vkFreeCommandBuffers(device, commandPool, 1, &handle);
+    });
     
     commandBuffer = nullptr;
 }
@@ -104,7 +117,10 @@ void VulkanCommandPool::DestroyCommandBuffers(std::vector<std::unique_ptr<Vulkan
         commandBuffer->m_CommandBuffer = VK_NULL_HANDLE;
     }
 
-    vkFreeCommandBuffers(m_Device->GetHandle(), m_CommandPool, bufferHandles.size(), bufferHandles.data());
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), commandPool = m_CommandPool, bufferHandles]()
+    {
+        vkFreeCommandBuffers(device, commandPool, bufferHandles.size(), bufferHandles.data());
+    });
     
     commandBuffers.clear();
 }
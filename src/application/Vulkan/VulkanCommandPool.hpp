@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 class VulkanCommandBuffer;
 
@@ -13,14 +14,26 @@ public:
     std::unique_ptr<VulkanCommandBuffer> CreatePrimaryBuffer();
     std::vector<std::unique_ptr<VulkanCommandBuffer>> CreatePrimaryBuffers(uint32_t bufferCount);
 
+    std::unique_ptr<VulkanCommandBuffer> CreateSecondaryBuffer();
+    std::vector<std::unique_ptr<VulkanCommandBuffer>> CreateSecondaryBuffers(uint32_t bufferCount);
+
+    // Returns every buffer allocated from the pool to the initial state at once.
+    // None of them may still be pending execution
+    void Reset(VkCommandPoolResetFlags flags = 0);
+
     void DestroyCommandBuffer(std::unique_ptr<VulkanCommandBuffer> commandBuffer);
     void DestroyCommandBuffers(std::vector<std::unique_ptr<VulkanCommandBuffer>>& commandBuffers);
     
     VkCommandPool GetHandle() const;
     std::shared_ptr<VulkanDevice> GetDevice() const;
 
+private:
+    std::vector<std::unique_ptr<VulkanCommandBuffer>> CreateBuffers(VkCommandBufferLevel level, uint32_t bufferCount);
+
 private:
     std::shared_ptr<VulkanDevice> m_Device;
     VkCommandPool m_CommandPool;
     uint32_t m_QueueFamilyIndex;
+
+    VulkanObjectTracker<VulkanObjectType::CommandPool> m_Tracker;
 };
\ No newline at end of file
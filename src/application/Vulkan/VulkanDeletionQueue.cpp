@@ -0,0 +1,83 @@
+#include "VulkanDeletionQueue.hpp"
+
+#include <algorithm>
+
+VulkanDeletionQueue::VulkanDeletionQueue()
+    : m_CurrentFrame(1), m_CompletedFrame(0)
+{
+}
+
+VulkanDeletionQueue::~VulkanDeletionQueue()
+{
+    Flush();
+}
+
+void VulkanDeletionQueue::Enqueue(std::function<void()> deleter)
+{
+    std::lock_guard lock(m_Mutex);
+
+    m_Entries.push_back({ m_CurrentFrame, std::move(deleter) });
+}
+
+uint64_t VulkanDeletionQueue::GetCurrentFrame() const
+{
+    std::lock_guard lock(m_Mutex);
+
+    return m_CurrentFrame;
+}
+
+uint64_t VulkanDeletionQueue::EndFrame()
+{
+    std::lock_guard lock(m_Mutex);
+
+    return m_CurrentFrame++;
+}
+
+void VulkanDeletionQueue::Collect(uint64_t completedFrame)
+{
+    std::deque<std::function<void()>> deleters;
+
+    {
+        std::lock_guard lock(m_Mutex);
+
+        m_CompletedFrame = std::max(m_CompletedFrame, completedFrame);
+
+        while(!m_Entries.empty() && m_Entries.front().Frame <= m_CompletedFrame)
+        {
+            deleters.push_back(std::move(m_Entries.front().Deleter));
+            m_Entries.pop_front();
+        }
+    }
+
+    Run(deleters);
+}
+
+void VulkanDeletionQueue::Flush()
+{
+    std::deque<std::function<void()>> deleters;
+
+    {
+        std::lock_guard lock(m_Mutex);
+
+        for(Entry& entry : m_Entries)
+            deleters.push_back(std::move(entry.Deleter));
+
+        m_Entries.clear();
+    }
+
+    Run(deleters);
+}
+
+size_t VulkanDeletionQueue::GetPendingCount() const
+{
+    std::lock_guard lock(m_Mutex);
+
+    return m_Entries.size();
+}
+
+void VulkanDeletionQueue::Run(std::deque<std::function<void()>>& deleters)
+{
+    // Outside the lock so deleters are free to release more objects
+    for(std::function<void()>& deleter : deleters)
+        deleter();
+}
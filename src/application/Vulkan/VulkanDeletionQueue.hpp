@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Vulkan/vulkan.hpp>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+
+// Destroys objects the GPU may still be using once the frame that last used them has completed.
+// Frames are numbered from 1; anything released while frame N is recorded is destroyed after N completes
+class VulkanDeletionQueue
+{
+public:
+    VulkanDeletionQueue();
+
+    // Runs every remaining deleter, the device has to be idle
+    ~VulkanDeletionQueue();
+
+    VulkanDeletionQueue(const VulkanDeletionQueue&) = delete;
+    VulkanDeletionQueue& operator=(const VulkanDeletionQueue&) = delete;
+
+    // |deleter| must only capture handles, never the wrapper being destroyed
+    void Enqueue(std::function<void()> deleter);
+
+    // Frame currently being recorded
+    uint64_t GetCurrentFrame() const;
+
+    // Call once the frame's work has been submitted. Returns the number of the submitted frame,
+    // to be passed to Collect once its fence has signaled
+    uint64_t EndFrame();
+
+    // Runs the deleters of every frame up to and including |completedFrame|
+    void Collect(uint64_t completedFrame);
+
+    // Runs every deleter regardless of frame, the device has to be idle
+    void Flush();
+
+    size_t GetPendingCount() const;
+
+private:
+    static void Run(std::deque<std::function<void()>>& deleters);
+
+private:
+    struct Entry
+    {
+        uint64_t Frame;
+        std::function<void()> Deleter;
+    };
+
+    // Ordered by frame since frames only ever advance
+    std::deque<Entry> m_Entries;
+
+    uint64_t m_CurrentFrame;
+    uint64_t m_CompletedFrame;
+
+    mutable std::mutex m_Mutex;
+};
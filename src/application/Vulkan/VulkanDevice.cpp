@@ -3,8 +3,10 @@
 #include "VulkanInstance.hpp"
 #include "VulkanQueue.hpp"
 
+#include <algorithm>
+
 VulkanDevice::VulkanDevice(std::shared_ptr<VulkanPhysicalDevice> physicalDevice, std::shared_ptr<VulkanDeviceRequirements> requirements)
-    : m_Instance(physicalDevice->GetInstance()), m_PhysicalDevice(physicalDevice)
+    : m_Instance(physicalDevice->GetInstance()), m_PhysicalDevice(physicalDevice), m_QueueSubmit2(nullptr)
 {
     auto familyCreateInfos = requirements->CombineQueueRequestIntoQueueFamilyCreateInfos();
     auto createInfos = GenerateCreateInfos(familyCreateInfos);
@@ -17,24 +19,51 @@ VulkanDevice::VulkanDevice(std::shared_ptr<VulkanPhysicalDevice> physicalDevice,
     createInfo.pQueueCreateInfos = createInfos.data();
     createInfo.queueCreateInfoCount = createInfos.size();
     createInfo.pEnabledFeatures = &deviceFeatures;
+
+    // Optional features, everything using them has a fallback. Chained back to front
+    void* optionalFeatures = nullptr;
+
+    // Queue submissions fall back to vkQueueSubmit without it
+    VkPhysicalDeviceSynchronization2Features synchronization2Features {};
+    synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+    synchronization2Features.synchronization2 = VK_TRUE;
+
+    if(m_PhysicalDevice->SupportsSynchronization2())
+    {
+        synchronization2Features.pNext = optionalFeatures;
+        optionalFeatures = &synchronization2Features;
+    }
+
+    // Frame synchronization falls back to fences without it
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures {};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+    timelineFeatures.timelineSemaphore = VK_TRUE;
+
+    if(m_PhysicalDevice->SupportsTimelineSemaphores())
+    {
+        timelineFeatures.pNext = optionalFeatures;
+        optionalFeatures = &timelineFeatures;
+    }
+
+    createInfo.pNext = optionalFeatures;
     
     std::vector<std::string> enabledExtension = physicalDevice->GetEnabledExtensions();
     std::vector<const char*> cStrExtensions;
 
-    if(enabledExtension.size() == 0)
+    for(auto& extension : enabledExtension)
     {
-        createInfo.enabledExtensionCount = 0;
+        cStrExtensions.push_back(extension.c_str());
     }
-    else
-    {
-        for(auto& extension : enabledExtension)
-        {
-            cStrExtensions.push_back(extension.c_str());
-        }
 
-        createInfo.enabledExtensionCount = static_cast<uint32_t>(cStrExtensions.size());
-        createInfo.ppEnabledExtensionNames = cStrExtensions.data();
+    // Not part of the requirements, devices without it shouldn't be rejected by the selector
+    if(m_PhysicalDevice->SupportsSynchronization2() &&
+        std::find(enabledExtension.begin(), enabledExtension.end(), VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME) == enabledExtension.end())
+    {
+        cStrExtensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
     }
+
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(cStrExtensions.size());
+    createInfo.ppEnabledExtensionNames = cStrExtensions.empty() ? nullptr : cStrExtensions.data();
     
     std::vector<const char*> ValidationLayers;
 
@@ -58,16 +87,33 @@ VulkanDevice::VulkanDevice(std::shared_ptr<VulkanPhysicalDevice> physicalDevice,
         throw std::runtime_error("Graphics error");
     }
 
-    Log.Info("Device created");
+    if(m_PhysicalDevice->SupportsSynchronization2())
+        m_QueueSubmit2 = reinterpret_cast<PFN_vkQueueSubmit2KHR>(vkGetDeviceProcAddr(m_Device, "vkQueueSubmit2KHR"));
+
+    m_Allocator = std::make_unique<VulkanMemoryAllocator>(m_Device, m_PhysicalDevice);
+    m_PipelineCache = std::make_unique<VulkanPipelineCache>(m_Device, m_PhysicalDevice, requirements->PipelineCachePath);
+    m_DeletionQueue = std::make_unique<VulkanDeletionQueue>();
+
+    LOG_DEBUG(VulkanLifetime, "Device created, timeline semaphores ", m_PhysicalDevice->SupportsTimelineSemaphores() ? "enabled" : "unavailable",
+        ", synchronization2 ", m_QueueSubmit2 ? "enabled" : "unavailable");
 }
 
 VulkanDevice::~VulkanDevice()
 {
+    // Wrappers released after the last WaitIdle, their deleters still need the allocator
+    vkDeviceWaitIdle(m_Device);
+    m_DeletionQueue.reset();
+
+    // Saves the cache one last time
+    m_PipelineCache.reset();
+
+    // Memory has to be released before the device goes away
+    m_Allocator.reset();
+
     vkDestroyDevice(m_Device, nullptr);
-    Log.Info("Device destructed");
 }
 
-const SwapchainSupportDetails VulkanDevice::GetSwapchainSupportDetails(VkSurfaceKHR surface)
+const SwapchainSupportDetails& VulkanDevice::GetSwapchainSupportDetails(VkSurfaceKHR surface)
 {
     return m_PhysicalDevice->GetSwapchainSupportDetails(surface);
 }
@@ -130,5 +176,9 @@ std::vector<VkDeviceQueueCreateInfo> VulkanDevice::GenerateCreateInfos(std::map<
 bool VulkanDevice::WaitIdle() const
 {
     VkResult result = vkDeviceWaitIdle(m_Device);
+
+    if(result == VK_SUCCESS)
+        m_DeletionQueue->Flush();
+
     return result == VK_SUCCESS;
 }
\ No newline at end of file
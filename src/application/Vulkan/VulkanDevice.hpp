@@ -1,6 +1,10 @@
 #pragma once
 
 #include "VulkanDeviceSelector.hpp"
+#include "VulkanMemoryAllocator.hpp"
+#include "VulkanPipelineCache.hpp"
+#include "VulkanDeletionQueue.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 #include <map>
 
@@ -24,13 +28,25 @@ public:
     ~VulkanDevice();
     
     VkDevice GetHandle() { return m_Device; }
+    std::shared_ptr<VulkanPhysicalDevice> GetPhysicalDevice() const { return m_PhysicalDevice; }
     
-    const SwapchainSupportDetails GetSwapchainSupportDetails(VkSurfaceKHR surface);
+    const SwapchainSupportDetails& GetSwapchainSupportDetails(VkSurfaceKHR surface);
     
     std::shared_ptr<VulkanQueue> GetQueue(const VulkanQueueRequest& request, int queueIndex);
 
+    // Enabled whenever the physical device supports them
+    bool HasTimelineSemaphores() const { return m_PhysicalDevice->SupportsTimelineSemaphores(); }
+
+    // vkQueueSubmit2KHR when synchronization2 is enabled, nullptr otherwise
+    PFN_vkQueueSubmit2KHR GetQueueSubmit2() const { return m_QueueSubmit2; }
+
+    // Also runs every pending deferred deletion since nothing can be in use anymore
     bool WaitIdle() const;
 
+    VulkanMemoryAllocator& GetAllocator() { return *m_Allocator; }
+    VulkanPipelineCache& GetPipelineCache() { return *m_PipelineCache; }
+    VulkanDeletionQueue& GetDeletionQueue() { return *m_DeletionQueue; }
+
 private:
     std::vector<VkDeviceQueueCreateInfo> GenerateCreateInfos(std::map<uint32_t, QueueFamilyCreateInfo>& familyInfos);
 
@@ -38,4 +54,11 @@ private:
     std::shared_ptr<VulkanInstance> m_Instance;
     std::shared_ptr<VulkanPhysicalDevice> m_PhysicalDevice;
     VkDevice m_Device;
+    PFN_vkQueueSubmit2KHR m_QueueSubmit2;
+
+    std::unique_ptr<VulkanMemoryAllocator> m_Allocator;
+    std::unique_ptr<VulkanPipelineCache> m_PipelineCache;
+    std::unique_ptr<VulkanDeletionQueue> m_DeletionQueue;
+
+    VulkanObjectTracker<VulkanObjectType::Device> m_Tracker;
 };
\ No newline at end of file
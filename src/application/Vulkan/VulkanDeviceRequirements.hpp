@@ -30,7 +30,17 @@ struct VulkanQueueRequest
     uint32_t Count;
     std::vector<float> Priorities;
 
+    // Only families without capabilities beyond |Flags| are considered, graphics and compute being the ones
+    // that matter. A dedicated transfer or compute queue runs alongside graphics instead of behind it
+    bool Dedicated = false;
+
+    // Missing queues don't disqualify the device, GetQueue returns nullptr for them instead
+    bool Optional = false;
+
     std::set<uint32_t> GetFamilyIndices();
+
+    // Number of queues the selected device provides for this request
+    uint32_t GetFulfilledCount() const { return static_cast<uint32_t>(QueueLocations.size()); }
     
 private:
     friend class VulkanDeviceRequirements;
@@ -67,6 +77,9 @@ public:
     std::vector<VulkanQueueRequest> Queues;
     std::vector<std::string> Extensions;
 
+    // Pipeline cache blob is loaded from and saved to this file. Empty keeps the cache in memory only
+    std::string PipelineCachePath;
+
 private:
     friend class VulkanDeviceSelector;
     friend class VulkanDevice;
@@ -10,19 +10,22 @@ VulkanDeviceSelector::VulkanDeviceSelector(std::shared_ptr<VulkanInstance> vulka
 
     for(auto device : physicalDevices)
     {
-        Log.Info(device->GetProperties().deviceName, " ", device->GetProperties().deviceType);
+        LOG_INFO(DeviceSelection, device->GetProperties().deviceName, " ", device->GetProperties().deviceType);
 
         for(auto family : device->GetQueueFamilyInfos())
         {
-            Log.Info(StandardFlagsToString(family.Properties.queueFlags), " Max Queues: ", family.Properties.queueCount);
+            LOG_INFO(DeviceSelection, StandardFlagsToString(family.Properties.queueFlags), " Max Queues: ", family.Properties.queueCount);
         }
     }
-    Log.Info("--------------");
+    LOG_INFO(DeviceSelection, "--------------");
 
     struct DeviceScore 
     {
         uint32_t DeviceIndex;
         int Value;
+
+        // Queues this device would provide, per request
+        std::vector<std::vector<QueueLocation>> QueueLocations;
     };
 
     std::vector<DeviceScore> scores;
@@ -32,7 +35,7 @@ VulkanDeviceSelector::VulkanDeviceSelector(std::shared_ptr<VulkanInstance> vulka
     {
         DeviceScore score;
         score.DeviceIndex = deviceIndex;
-        score.Value = ScoreDevice(device); 
+        score.Value = ScoreDevice(device, score.QueueLocations);
         
         scores.push_back(score);
 
@@ -42,17 +45,21 @@ VulkanDeviceSelector::VulkanDeviceSelector(std::shared_ptr<VulkanInstance> vulka
     // Sort device scores in descending order
     std::sort(scores.begin(), scores.end(), [](const DeviceScore& lhs, const DeviceScore& rhs)
     {
-        return lhs.Value < rhs.Value;
+        return lhs.Value > rhs.Value;
     });
 
     DeviceScore bestDevice = scores[0];
 
     if(bestDevice.Value < 0)
     {
-        Log.Error("Queue requests couldn't be fulfilled");
+        LOG_ERROR(DeviceSelection, "Queue requests couldn't be fulfilled");
         throw std::runtime_error("Failed to find suitable physical device");
     }
 
+    // Only the chosen device's queues make it into the requirements the device gets created from
+    for(size_t i = 0; i < m_DeviceRequirements->Queues.size(); i++)
+        m_DeviceRequirements->Queues[i].QueueLocations = bestDevice.QueueLocations[i];
+
     m_Device = std::make_shared<VulkanDevice>(physicalDevices[bestDevice.DeviceIndex], m_DeviceRequirements);
 }
 
@@ -73,7 +80,7 @@ bool VulkanDeviceSelector::CheckSurfaceSupport(std::shared_ptr<VulkanPhysicalDev
     
     if(result != VK_SUCCESS)
     {
-        Log.Error("Failed to query device surface support");
+        LOG_ERROR(DeviceSelection, "Failed to query device surface support");
         throw std::runtime_error("Vulkan did an oopsie");
     }
 
@@ -92,14 +99,17 @@ bool VulkanDeviceSelector::FlagsArePresent(VkQueueFlags flags1, VkQueueFlags fla
     return ((flags2 & flags1) == flags1);
 }
 
-std::vector<VulkanQueueFamilyInfo> VulkanDeviceSelector::FindSuitableFamilies(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice, VkQueueFlags requiredFlags)
+std::vector<VulkanQueueFamilyInfo> VulkanDeviceSelector::FindSuitableFamilies(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice, const VulkanQueueRequest& request)
 {
     std::vector<VulkanQueueFamilyInfo> result;
 
+    // Transfer is implied by graphics and compute, so those two are what tells a dedicated family apart
+    const VkQueueFlags excludedFlags = request.Dedicated ? (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT) & ~request.Flags : 0;
+
     auto& queueFamilies = physicalDevice->GetQueueFamilyInfos();
     std::copy_if(queueFamilies.begin(), queueFamilies.end(), std::back_inserter(result), [&](const VulkanQueueFamilyInfo& info)
     {
-        return FlagsArePresent(requiredFlags, info.Properties.queueFlags);
+        return FlagsArePresent(request.Flags, info.Properties.queueFlags) && (info.Properties.queueFlags & excludedFlags) == 0;
     });
 
     std::sort(result.begin(), result.end(), [&](const VulkanQueueFamilyInfo& lhs, const VulkanQueueFamilyInfo& rhs)
@@ -115,41 +125,43 @@ bool VulkanDeviceSelector::DoesDeviceSupportExtensions(std::shared_ptr<VulkanPhy
     if(m_DeviceRequirements->Extensions.size() == 0)
         return true;
 
-    Log.Info("Checking whether the device supports required extensions");
+    LOG_INFO(DeviceSelection, "Checking whether the device supports required extensions");
     std::set<std::string> required(m_DeviceRequirements->Extensions.begin(), m_DeviceRequirements->Extensions.end());
 
-    Log.Info("Requested extensions");
+    LOG_INFO(DeviceSelection, "Requested extensions");
     for(auto ext : required)
     {
-        Log.Info("    ", ext);
+        LOG_INFO(DeviceSelection, "    ", ext);
     }
     
-    Log.Info("Following extensions are available");
+    LOG_INFO(DeviceSelection, "Following extensions are available");
     for(auto extension : physicalDevice->GetExtensions())
     {
         if(required.erase(extension) > 0)
         {
-            Log.Info("    ", extension);
+            LOG_INFO(DeviceSelection, "    ", extension);
             physicalDevice->EnableExtension(extension);
         }
     }
 
     if(required.size() > 0)
     {
-        Log.Info("Not all required device extensions were available");
+        LOG_INFO(DeviceSelection, "Not all required device extensions were available");
         for(auto ext : required)
         {
-            Log.Info("    ", ext);
+            LOG_INFO(DeviceSelection, "    ", ext);
         }
     }
 
     return required.empty();
 }
 
-bool VulkanDeviceSelector::DoesDeviceSupportRequests(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice)
+bool VulkanDeviceSelector::DoesDeviceSupportRequests(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice, std::vector<std::vector<QueueLocation>>& queueLocations)
 {
     size_t requestCount = m_DeviceRequirements->Queues.size();
 
+    queueLocations.assign(requestCount, {});
+
     // Each element represents the number of queues requested of that type which we will attempt to fulfill. ie. at the end it should all be zeros
     std::vector<int> unfulfilledRequestedQueueCount;
 
@@ -170,34 +182,35 @@ bool VulkanDeviceSelector::DoesDeviceSupportRequests(std::shared_ptr<VulkanPhysi
     // Attempt to fullfil each queue request by assigning queues from the physical device to match the requests
     for(size_t i = 0; i < requestCount; i++)
     {
-        VulkanQueueRequest& request = m_DeviceRequirements->Queues[i];
+        const VulkanQueueRequest& request = m_DeviceRequirements->Queues[i];
+        std::vector<QueueLocation>& locations = queueLocations[i];
 
         if(request.Surface.has_value())
         {
-            auto swapchainDetails = physicalDevice->GetSwapchainSupportDetails(request.Surface.value());
+            const auto& swapchainDetails = physicalDevice->GetSwapchainSupportDetails(request.Surface.value());
 
             if(swapchainDetails.Formats.empty())
             {
-                Log.Info("Physical device provided 0 swapchain formats");
+                LOG_INFO(DeviceSelection, "Physical device provided 0 swapchain formats");
                 // No swapchain formats available
                 return false;
             }
 
             if(swapchainDetails.PresentModes.empty())
             {
-                Log.Info("Physical device provided 0 swapchain present modes");
+                LOG_INFO(DeviceSelection, "Physical device provided 0 swapchain present modes");
                 // No present modes available
                 return false;
             }
         }
 
-        auto suitableFamilies = FindSuitableFamilies(physicalDevice, request.Flags);
+        auto suitableFamilies = FindSuitableFamilies(physicalDevice, request);
 
         for(auto family : suitableFamilies)
         {
             if(familyQueuesLeft[family.Index] == 0)
             {
-                Log.Info("Family queues hit zero");
+                LOG_INFO(DeviceSelection, "Family queues hit zero");
                 continue;
             }
                 
@@ -213,7 +226,7 @@ bool VulkanDeviceSelector::DoesDeviceSupportRequests(std::shared_ptr<VulkanPhysi
                 // calculate new index to be used within a family
                 uint32_t index = family.Properties.queueCount - familyQueuesLeft[family.Index] + i;
 
-                request.QueueLocations.emplace_back(family.Index, index);
+                locations.emplace_back(family.Index, index);
             }
 
             // These could be done inside the for above but I honestly can't be asked to do that rn
@@ -223,7 +236,13 @@ bool VulkanDeviceSelector::DoesDeviceSupportRequests(std::shared_ptr<VulkanPhysi
 
         if(unfulfilledRequestedQueueCount[i] > 0)
         {
-            Log.Info("Not all requested queues could be provided");
+            if(request.Optional)
+            {
+                LOG_INFO(DeviceSelection, "Optional queue request ", StandardFlagsToString(request.Flags), " got ", locations.size(), " of ", request.Count, " queues");
+                continue;
+            }
+
+            LOG_INFO(DeviceSelection, "Not all requested queues could be provided");
             return false;
         }
     }
@@ -266,7 +285,7 @@ VkQueueFlags VulkanDeviceSelector::SanitizeQueueFlags(VkQueueFlags flags) const
     return (flags & validFlagMask);
 }
 
-int VulkanDeviceSelector::ScoreDevice(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice)
+int VulkanDeviceSelector::ScoreDevice(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice, std::vector<std::vector<QueueLocation>>& queueLocations)
 {
     int score = 0;
 
@@ -282,7 +301,7 @@ int VulkanDeviceSelector::ScoreDevice(std::shared_ptr<VulkanPhysicalDevice>& phy
         return -1;
     }
     
-    bool queueRequestsSupport = DoesDeviceSupportRequests(physicalDevice);
+    bool queueRequestsSupport = DoesDeviceSupportRequests(physicalDevice, queueLocations);
     
     if(!queueRequestsSupport)
     {
@@ -11,6 +11,8 @@
 #include <map>
 #include <set>
 
+class VulkanDevice;
+
 class VulkanDeviceSelector
 {
 public:
@@ -35,19 +37,21 @@ private:
     // return true if flags1 are present in flags2
     bool FlagsArePresent(VkQueueFlags flags1, VkQueueFlags flags2) const;
 
-    // Return all families containing atleast |request.Flags| flags (ascending order)
-    std::vector<VulkanQueueFamilyInfo> FindSuitableFamilies(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice, VkQueueFlags requiredFlags);
+    // Return all families containing atleast |request.Flags| flags (ascending order).
+    // Dedicated requests also skip families with graphics or compute support they didn't ask for
+    std::vector<VulkanQueueFamilyInfo> FindSuitableFamilies(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice, const VulkanQueueRequest& request);
 
     bool DoesDeviceSupportExtensions(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice);
 
-    // Returns true if the device can provide all requested queues
-    bool DoesDeviceSupportRequests(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice);
+    // Returns true if the device can provide all requested queues. |queueLocations| gets the queues picked for each request,
+    // the requirements are left alone until a device has been chosen
+    bool DoesDeviceSupportRequests(std::shared_ptr<VulkanPhysicalDevice>& physicalDevice, std::vector<std::vector<QueueLocation>>& queueLocations);
 
     std::string StandardFlagsToString(VkQueueFlags flags) const;
 
     VkQueueFlags SanitizeQueueFlags(VkQueueFlags flags) const;
 
-    int ScoreDevice(std::shared_ptr<VulkanPhysicalDevice>& device);
+    int ScoreDevice(std::shared_ptr<VulkanPhysicalDevice>& device, std::vector<std::vector<QueueLocation>>& queueLocations);
 
 private:
     std::shared_ptr<VulkanInstance> m_Instance;
@@ -14,14 +14,14 @@ VulkanFence::VulkanFence(std::shared_ptr<VulkanDevice> device, VkFenceCreateFlag
         Log.Error("Failed to create fence");
         throw std::runtime_error("Vulkan error");
     }
-
-    Log.Info("Fence created");
 }
 
 VulkanFence::~VulkanFence()
 {
-    vkDestroyFence(m_Device->GetHandle(), m_Fence, nullptr);
-    Log.Info("Fence destructed");
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), fence = m_Fence]()
+    {
+        vkDestroyFence(device, fence, nullptr);
+    });
 }
 
 VkResult VulkanFence::Wait(uint64_t timeout)
@@ -43,6 +43,11 @@ VkResult VulkanFence::Reset()
     return result;
 }
 
+bool VulkanFence::IsSignaled() const
+{
+    return vkGetFenceStatus(m_Device->GetHandle(), m_Fence) == VK_SUCCESS;
+}
+
 VkFence VulkanFence::GetHandle() const
 {
     return m_Fence;
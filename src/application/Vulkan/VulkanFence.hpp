@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 class VulkanFence
 {
@@ -11,9 +12,14 @@ public:
     VkResult Wait(uint64_t timeout = std::numeric_limits<uint64_t>::max());
     VkResult Reset();
 
+    // Polls without blocking
+    bool IsSignaled() const;
+
     VkFence GetHandle() const;
 
 private:
     std::shared_ptr<VulkanDevice> m_Device;
     VkFence m_Fence;
+
+    VulkanObjectTracker<VulkanObjectType::Fence> m_Tracker;
 };
\ No newline at end of file
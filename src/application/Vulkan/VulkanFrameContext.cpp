@@ -0,0 +1,62 @@
+#include "VulkanFrameContext.hpp"
+
+#include <algorithm>
+
+VulkanFrameContextRing::VulkanFrameContextRing
+(
+    std::shared_ptr<VulkanDevice> device,
+    std::shared_ptr<VulkanQueue> queue,
+    uint32_t depth,
+    VkDeviceSize uploadBytesPerFrame,
+    VkBufferUsageFlags uploadUsage
+)
+    : m_Device(device),
+      m_Queue(queue),
+      m_Frames(std::max(depth, 1u)),
+      m_FrameIndex(0),
+      m_UploadRing(device, std::max(depth, 1u), uploadBytesPerFrame, uploadUsage),
+      m_CommandRecorder(device, queue->GetFamilyIndex(), std::max(depth, 1u))
+{
+    for(uint32_t i = 0; i < m_Frames.size(); i++)
+    {
+        VulkanFrameContext& frame = m_Frames[i];
+        frame.Index = i;
+
+        // The primary buffer is recorded once per frame, resetting the whole pool is enough
+        frame.CommandPool = std::make_shared<VulkanCommandPool>(device, queue->GetFamilyIndex(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+        frame.CommandBuffer = frame.CommandPool->CreatePrimaryBuffer();
+        frame.ImageAvailableSemaphore = std::make_unique<VulkanSemaphore>(device);
+    }
+
+    LOG_DEBUG(VulkanLifetime, "FrameContextRing created with ", m_Frames.size(), " frames in flight");
+}
+
+VulkanFrameContextRing::~VulkanFrameContextRing()
+{
+    // Buffers are freed along with their pools
+}
+
+VulkanFrameContext& VulkanFrameContextRing::BeginFrame()
+{
+    VulkanFrameContext& frame = m_Frames[m_FrameIndex];
+
+    m_Queue->WaitForValue(frame.TimelineValue);
+
+    m_Device->GetDeletionQueue().Collect(frame.DeletionFrame);
+
+    frame.CommandPool->Reset();
+    m_UploadRing.BeginFrame(frame.Index);
+    m_CommandRecorder.BeginFrame(frame.Index);
+
+    return frame;
+}
+
+void VulkanFrameContextRing::EndFrame(uint64_t timelineValue)
+{
+    VulkanFrameContext& frame = m_Frames[m_FrameIndex];
+
+    frame.TimelineValue = timelineValue;
+    frame.DeletionFrame = m_Device->GetDeletionQueue().EndFrame();
+
+    m_FrameIndex = (m_FrameIndex + 1) % m_Frames.size();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "VulkanCommandBuffer.hpp"
+#include "VulkanSemaphore.hpp"
+#include "VulkanQueue.hpp"
+#include "VulkanUploadRing.hpp"
+#include "VulkanParallelCommandRecorder.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+// State owned by one frame in flight. None of it is touched by the CPU again until the
+// frame's submission has completed on the GPU
+struct VulkanFrameContext
+{
+    uint32_t Index = 0;
+
+    std::shared_ptr<VulkanCommandPool> CommandPool;
+    std::unique_ptr<VulkanCommandBuffer> CommandBuffer;
+
+    // Signaled by the swapchain acquire, waited on by the frame's submission
+    std::unique_ptr<VulkanSemaphore> ImageAvailableSemaphore;
+
+    // Queue timeline value of the frame's last submission, 0 before the first one
+    uint64_t TimelineValue = 0;
+
+    // Deletion queue frame released resources were queued under while this frame was recorded
+    uint64_t DeletionFrame = 0;
+};
+
+// Ring of frame contexts plus the transient allocators indexed by them. The depth only decides how far
+// the CPU may run ahead of the GPU and is unrelated to the swapchain image count, presentation
+// semaphores belong to swapchain images and live with them
+class VulkanFrameContextRing
+{
+public:
+    VulkanFrameContextRing(
+        std::shared_ptr<VulkanDevice> device,
+        std::shared_ptr<VulkanQueue> queue,
+        uint32_t depth,
+        VkDeviceSize uploadBytesPerFrame,
+        VkBufferUsageFlags uploadUsage
+    );
+
+    ~VulkanFrameContextRing();
+
+    VulkanFrameContextRing(const VulkanFrameContextRing&) = delete;
+    VulkanFrameContextRing& operator=(const VulkanFrameContextRing&) = delete;
+
+    // Waits until the current context's previous submission has completed, then reclaims its command
+    // pool, upload region, secondary buffers and deferred deletions. Calling it again without
+    // EndFrame, e.g. after a failed acquire, reuses the same context
+    VulkanFrameContext& BeginFrame();
+
+    // Records that the current context was submitted as |timelineValue| on the ring's queue and moves on
+    void EndFrame(uint64_t timelineValue);
+
+    VulkanFrameContext& GetCurrentFrame() { return m_Frames[m_FrameIndex]; }
+    uint32_t GetDepth() const { return static_cast<uint32_t>(m_Frames.size()); }
+
+    VulkanUploadRing& GetUploadRing() { return m_UploadRing; }
+    VulkanParallelCommandRecorder& GetCommandRecorder() { return m_CommandRecorder; }
+
+private:
+    std::shared_ptr<VulkanDevice> m_Device;
+    std::shared_ptr<VulkanQueue> m_Queue;
+
+    std::vector<VulkanFrameContext> m_Frames;
+    uint32_t m_FrameIndex;
+
+    VulkanUploadRing m_UploadRing;
+    VulkanParallelCommandRecorder m_CommandRecorder;
+
+    VulkanObjectTracker<VulkanObjectType::FrameContextRing> m_Tracker;
+};
@@ -28,14 +28,16 @@ VulkanFramebuffer::VulkanFramebuffer(std::shared_ptr<VulkanRenderPass> renderPas
         Log.Error("Failed to create framebuffer");
         throw std::runtime_error("Vulkan error");
     }
-
-    Log.Info("Framebuffer created");
 }
 
 VulkanFramebuffer::~VulkanFramebuffer()
 {
-    vkDestroyFramebuffer(m_RenderPass->GetDevice()->GetHandle(), m_Framebuffer, nullptr);
-    Log.Info("Framebuffer destructed");
+    std::shared_ptr<VulkanDevice> device = m_RenderPass->GetDevice();
+
+    device->GetDeletionQueue().Enqueue([deviceHandle = device->GetHandle(), framebuffer = m_Framebuffer]()
+    {
+        vkDestroyFramebuffer(deviceHandle, framebuffer, nullptr);
+    });
 }
 
 VkFramebuffer VulkanFramebuffer::GetHandle() const
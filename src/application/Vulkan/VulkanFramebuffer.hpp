@@ -3,6 +3,7 @@
 #include "VulkanDevice.hpp"
 #include "VulkanImageView.hpp"
 #include "VulkanRenderPass.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 class VulkanRenderPass;
 
@@ -22,4 +23,6 @@ private:
     std::shared_ptr<VulkanImageView> m_Attachment;
 
     VkExtent2D m_Extent;
+
+    VulkanObjectTracker<VulkanObjectType::Framebuffer> m_Tracker;
 };
\ No newline at end of file
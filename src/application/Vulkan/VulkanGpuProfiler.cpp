@@ -0,0 +1,182 @@
+#include "VulkanGpuProfiler.hpp"
+
+#include <algorithm>
+
+VulkanGpuProfiler::VulkanGpuProfiler(std::shared_ptr<VulkanDevice> device, uint32_t queueFamilyIndex, uint32_t frameCount, uint32_t maxScopesPerFrame)
+    : m_Device(device), m_FrameIndex(0), m_QueriesPerFrame(maxScopesPerFrame * 2), m_TimestampMask(0), m_NanosecondsPerTick(0.0), m_FrameNumber(0)
+{
+    std::shared_ptr<VulkanPhysicalDevice> physicalDevice = device->GetPhysicalDevice();
+
+    uint32_t validBits = physicalDevice->GetQueueFamilyInfos()[queueFamilyIndex].Properties.timestampValidBits;
+    m_NanosecondsPerTick = physicalDevice->GetProperties().limits.timestampPeriod;
+
+    if(validBits == 0 || m_NanosecondsPerTick <= 0.0)
+    {
+        Log.Info("GpuProfiler disabled, queue family ", queueFamilyIndex, " doesn't support timestamps");
+        return;
+    }
+
+    m_TimestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+    m_Frames.resize(frameCount);
+    for(uint32_t i = 0; i < frameCount; i++)
+        m_Frames[i].FirstQuery = i * m_QueriesPerFrame;
+
+    m_QueryPool = std::make_unique<VulkanQueryPool>(device, VK_QUERY_TYPE_TIMESTAMP, frameCount * m_QueriesPerFrame);
+
+    LOG_DEBUG(VulkanLifetime, "GpuProfiler created with ", maxScopesPerFrame, " scopes per frame, ", m_NanosecondsPerTick, " ns per tick");
+}
+
+VulkanGpuProfiler::~VulkanGpuProfiler()
+{
+}
+
+void VulkanGpuProfiler::BeginFrame(VulkanCommandBuffer& commandBuffer, uint32_t frameIndex)
+{
+    if(!IsEnabled())
+        return;
+
+    if(!m_OpenScopes.empty())
+        Log.Warn("GpuProfiler frame ended with ", m_OpenScopes.size(), " open scopes");
+
+    m_OpenScopes.clear();
+    m_FrameIndex = frameIndex;
+
+    FrameQueries& frame = m_Frames[m_FrameIndex];
+
+    CollectResults(frame);
+
+    frame.FrameNumber = m_FrameNumber++;
+    frame.UsedQueries = 0;
+    frame.Scopes.clear();
+
+    // Queries have to be reset before they're written again, and resets aren't allowed inside a render pass
+    commandBuffer.ResetQueryPool(*m_QueryPool, frame.FirstQuery, m_QueriesPerFrame);
+}
+
+void VulkanGpuProfiler::BeginScope(VulkanCommandBuffer& commandBuffer, const char* name, VkPipelineStageFlagBits stage)
+{
+    if(!IsEnabled())
+        return;
+
+    FrameQueries& frame = m_Frames[m_FrameIndex];
+
+    // Out of queries, the scope is dropped but EndScope still has to match it
+    if(frame.UsedQueries + 2 > m_QueriesPerFrame)
+    {
+        m_OpenScopes.push_back(UINT32_MAX);
+        return;
+    }
+
+    PendingScope scope {};
+    scope.Name = name;
+    scope.Depth = static_cast<uint32_t>(m_OpenScopes.size());
+    scope.BeginQuery = AllocateQuery(frame);
+
+    // Reserved now so a full frame can't leave a begun scope without its end
+    scope.EndQuery = AllocateQuery(frame);
+
+    commandBuffer.WriteTimestamp(*m_QueryPool, scope.BeginQuery, stage);
+
+    m_OpenScopes.push_back(static_cast<uint32_t>(frame.Scopes.size()));
+    frame.Scopes.push_back(scope);
+}
+
+void VulkanGpuProfiler::EndScope(VulkanCommandBuffer& commandBuffer, VkPipelineStageFlagBits stage)
+{
+    if(!IsEnabled())
+        return;
+
+    if(m_OpenScopes.empty())
+    {
+        Log.Warn("GpuProfiler EndScope without a matching BeginScope");
+        return;
+    }
+
+    uint32_t scopeIndex = m_OpenScopes.back();
+    m_OpenScopes.pop_back();
+
+    if(scopeIndex == UINT32_MAX)
+        return;
+
+    const PendingScope& scope = m_Frames[m_FrameIndex].Scopes[scopeIndex];
+    commandBuffer.WriteTimestamp(*m_QueryPool, scope.EndQuery, stage);
+}
+
+bool VulkanGpuProfiler::SetOutputFile(const std::string& path)
+{
+    m_OutputFile.open(path, std::ios::out | std::ios::trunc);
+
+    if(!m_OutputFile.is_open())
+    {
+        Log.Error("GpuProfiler failed to open ", path);
+        return false;
+    }
+
+    m_OutputFile << "frame,scope,depth,ms\n";
+    return true;
+}
+
+void VulkanGpuProfiler::LogLatest() const
+{
+    Log.Info("GpuProfiler frame ", m_LatestTimings.FrameNumber);
+
+    for(const VulkanGpuScopeResult& scope : m_LatestTimings.Scopes)
+        Log.Info("    ", std::string(scope.Depth * 2, ' '), scope.Name, " ", scope.Milliseconds, " ms");
+}
+
+void VulkanGpuProfiler::LogStats() const
+{
+    if(!IsEnabled())
+        return;
+
+    Log.Info("GpuProfiler scope timings");
+
+    for(const auto& [name, stats] : m_ScopeStats)
+        Log.Info("    ", name, " avg ", stats.GetAverageMilliseconds(), " ms, max ", stats.MaxMilliseconds, " ms over ", stats.Samples, " frames");
+}
+
+void VulkanGpuProfiler::CollectResults(FrameQueries& frame)
+{
+    if(frame.UsedQueries == 0)
+        return;
+
+    // The frame's fence or timeline value has been waited on already, so this normally doesn't come back short.
+    // Unavailable scopes are skipped rather than waited for
+    if(!m_QueryPool->GetResults(frame.FirstQuery, frame.UsedQueries, m_Results))
+        return;
+
+    VulkanGpuFrameTimings timings;
+    timings.FrameNumber = frame.FrameNumber;
+    timings.Scopes.reserve(frame.Scopes.size());
+
+    for(const PendingScope& scope : frame.Scopes)
+    {
+        uint32_t begin = (scope.BeginQuery - frame.FirstQuery) * 2;
+        uint32_t end = (scope.EndQuery - frame.FirstQuery) * 2;
+
+        // The second value of each pair is the availability
+        if(m_Results[begin + 1] == 0 || m_Results[end + 1] == 0)
+            continue;
+
+        uint64_t ticks = (m_Results[end] - m_Results[begin]) & m_TimestampMask;
+        double milliseconds = ticks * m_NanosecondsPerTick / 1000000.0;
+
+        timings.Scopes.push_back({ scope.Name, scope.Depth, milliseconds });
+
+        VulkanGpuScopeStats& stats = m_ScopeStats[scope.Name];
+        stats.Samples++;
+        stats.TotalMilliseconds += milliseconds;
+        stats.MaxMilliseconds = std::max(stats.MaxMilliseconds, milliseconds);
+
+        if(m_OutputFile.is_open())
+            m_OutputFile << timings.FrameNumber << ',' << scope.Name << ',' << scope.Depth << ',' << milliseconds << '\n';
+    }
+
+    m_LatestTimings = std::move(timings);
+}
+
+uint32_t VulkanGpuProfiler::AllocateQuery(FrameQueries& frame)
+{
+    return frame.FirstQuery + frame.UsedQueries++;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "VulkanQueryPool.hpp"
+#include "VulkanCommandBuffer.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+struct VulkanGpuScopeResult
+{
+    std::string Name;
+
+    // Nesting level, 0 for scopes that were opened outside of any other
+    uint32_t Depth;
+
+    double Milliseconds;
+};
+
+struct VulkanGpuFrameTimings
+{
+    uint64_t FrameNumber = 0;
+
+    // In the order the scopes were opened
+    std::vector<VulkanGpuScopeResult> Scopes;
+};
+
+struct VulkanGpuScopeStats
+{
+    uint32_t Samples = 0;
+    double TotalMilliseconds = 0.0;
+    double MaxMilliseconds = 0.0;
+
+    double GetAverageMilliseconds() const { return Samples > 0 ? TotalMilliseconds / Samples : 0.0; }
+};
+
+// Times named scopes of a frame's primary command buffer with timestamp queries. Every frame in flight has
+// its own range of queries, read back when the frame comes around again so the CPU never waits on the GPU.
+// Recording and readback happen on the render thread only
+class VulkanGpuProfiler
+{
+public:
+    VulkanGpuProfiler(std::shared_ptr<VulkanDevice> device, uint32_t queueFamilyIndex, uint32_t frameCount, uint32_t maxScopesPerFrame = 64);
+    ~VulkanGpuProfiler();
+
+    VulkanGpuProfiler(const VulkanGpuProfiler&) = delete;
+    VulkanGpuProfiler& operator=(const VulkanGpuProfiler&) = delete;
+
+    // Collects the results |frameIndex| recorded last time around and resets its queries on |commandBuffer|.
+    // Must be recorded outside of a render pass, after the frame's previous submission has completed
+    void BeginFrame(VulkanCommandBuffer& commandBuffer, uint32_t frameIndex);
+
+    // |name| must outlive the frame, string literals are expected
+    void BeginScope(VulkanCommandBuffer& commandBuffer, const char* name, VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    void EndScope(VulkanCommandBuffer& commandBuffer, VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+    // False when the queue family can't write timestamps, scopes are ignored then
+    bool IsEnabled() const { return m_QueryPool != nullptr; }
+
+    // Most recent frame whose results have come back, lags the recorded frame by at least the frame count
+    const VulkanGpuFrameTimings& GetLatestTimings() const { return m_LatestTimings; }
+    const std::unordered_map<std::string, VulkanGpuScopeStats>& GetScopeStats() const { return m_ScopeStats; }
+
+    // Appends every collected frame to |path| as csv, one scope per line
+    bool SetOutputFile(const std::string& path);
+
+    void LogLatest() const;
+    void LogStats() const;
+
+private:
+    struct PendingScope
+    {
+        const char* Name;
+        uint32_t Depth;
+        uint32_t BeginQuery;
+        uint32_t EndQuery;
+    };
+
+    struct FrameQueries
+    {
+        uint64_t FrameNumber = 0;
+        uint32_t FirstQuery = 0;
+        uint32_t UsedQueries = 0;
+        std::vector<PendingScope> Scopes;
+    };
+
+    void CollectResults(FrameQueries& frame);
+    uint32_t AllocateQuery(FrameQueries& frame);
+
+private:
+    std::shared_ptr<VulkanDevice> m_Device;
+    std::unique_ptr<VulkanQueryPool> m_QueryPool;
+
+    std::vector<FrameQueries> m_Frames;
+    uint32_t m_FrameIndex;
+    uint32_t m_QueriesPerFrame;
+
+    // Timestamps only carry this many bits, the rest are undefined
+    uint64_t m_TimestampMask;
+    double m_NanosecondsPerTick;
+
+    uint64_t m_FrameNumber;
+
+    // Indices into the current frame's scopes that haven't been ended yet
+    std::vector<uint32_t> m_OpenScopes;
+    std::vector<uint64_t> m_Results;
+
+    VulkanGpuFrameTimings m_LatestTimings;
+    std::unordered_map<std::string, VulkanGpuScopeStats> m_ScopeStats;
+
+    std::ofstream m_OutputFile;
+
+    VulkanObjectTracker<VulkanObjectType::GpuProfiler> m_Tracker;
+};
@@ -12,6 +12,7 @@
 #include "VulkanPipelineDynamicState.hpp"
 #include "VulkanPipelineLayout.hpp"
 #include "VulkanRenderPass.hpp"
+#include "VulkanGraphicsPipelineDescription.hpp"
 
 VulkanGraphicsPipeline::VulkanGraphicsPipeline
 (
@@ -51,18 +52,37 @@ VulkanGraphicsPipeline::VulkanGraphicsPipeline
     pipelineInfo.basePipelineHandle = basePipeline ? basePipeline->GetHandle() : VK_NULL_HANDLE;
     pipelineInfo.basePipelineIndex = basePipelineIndex;
 
-    VkResult result = vkCreateGraphicsPipelines(device->GetHandle(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_Pipeline);
+    VkResult result = vkCreateGraphicsPipelines(device->GetHandle(), device->GetPipelineCache().GetHandle(), 1, &pipelineInfo, nullptr, &m_Pipeline);
 
     if(result != VK_SUCCESS)
     {
         Log.Error("Failed to create graphics pipeline");
         throw std::runtime_error("Vulkan error");
     }
+}
 
-    Log.Info("GraphicsPipeline created");
+VulkanGraphicsPipeline::VulkanGraphicsPipeline
+(
+    std::shared_ptr<VulkanDevice> device,
+    const VulkanGraphicsPipelineDescription& description
+) : VulkanGraphicsPipeline(
+        device,
+        description.ShaderStages,
+        description.VertexInputState,
+        description.InputAssemblyState,
+        description.ViewportState,
+        description.RasterizationState,
+        description.MultisampleState,
+        description.DepthStencilState,
+        description.ColorBlendState,
+        description.DynamicState,
+        description.Layout,
+        description.RenderPass,
+        description.Subpass
+    )
+{
 }
 
 VulkanGraphicsPipeline::~VulkanGraphicsPipeline()
 {
-    Log.Info("GraphicsPipeline destructed");
 }
\ No newline at end of file
@@ -13,6 +13,7 @@ class VulkanPipelineColorBlendState;
 class VulkanPipelineDynamicState;
 class VulkanPipelineLayout;
 class VulkanRenderPass;
+struct VulkanGraphicsPipelineDescription;
 
 class VulkanGraphicsPipeline : public VulkanPipeline
 {
@@ -34,6 +35,8 @@ public:
         std::shared_ptr<VulkanGraphicsPipeline> basePipeline = nullptr,
         int32_t basePipelineIndex = -1
     );
+
+    VulkanGraphicsPipeline(std::shared_ptr<VulkanDevice> device, const VulkanGraphicsPipelineDescription& description);
     
     ~VulkanGraphicsPipeline();
 };
\ No newline at end of file
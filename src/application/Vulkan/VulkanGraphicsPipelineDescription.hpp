@@ -0,0 +1,40 @@
+#pragma once
+
+#include "VulkanPipelineShaderStage.hpp"
+#include "VulkanPipelineVertexInputState.hpp"
+#include "VulkanPipelineInputAssemblyState.hpp"
+#include "VulkanPipelineViewportState.hpp"
+#include "VulkanPipelineRasterizationState.hpp"
+#include "VulkanPipelineMultisampleState.hpp"
+#include "VulkanPipelineDepthStencilState.hpp"
+#include "VulkanPipelineColorBlendState.hpp"
+#include "VulkanPipelineDynamicState.hpp"
+
+#include <memory>
+#include <vector>
+
+class VulkanPipelineLayout;
+class VulkanRenderPass;
+class VulkanShaderModule;
+
+// Everything needed to build a graphics pipeline, held by value so it can be handed to another thread.
+// Shader entry point names, specialization info and the sample mask are still referenced, not copied
+struct VulkanGraphicsPipelineDescription
+{
+    std::vector<VulkanPipelineShaderStage> ShaderStages;
+    VulkanPipelineVertexInputState VertexInputState;
+    VulkanPipelineInputAssemblyState InputAssemblyState;
+    VulkanPipelineViewportState ViewportState;
+    VulkanPipelineRasterizationState RasterizationState;
+    VulkanPipelineMultisampleState MultisampleState;
+    VulkanPipelineDepthStencilState DepthStencilState;
+    VulkanPipelineColorBlendState ColorBlendState;
+    VulkanPipelineDynamicState DynamicState;
+    std::shared_ptr<VulkanPipelineLayout> Layout;
+    std::shared_ptr<VulkanRenderPass> RenderPass;
+    int32_t Subpass = 0;
+
+    // The modules |ShaderStages| refer to, kept alive for as long as the description or a pipeline library entry
+    // built from it. Stages whose module isn't listed here keep the pipeline out of the library
+    std::vector<std::shared_ptr<VulkanShaderModule>> ShaderModules;
+};
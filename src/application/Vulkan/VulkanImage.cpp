@@ -8,13 +8,15 @@ VulkanImage::VulkanImage
     VkFormat format
 ) : m_Image(handle), m_Device(device), m_Extent(extent), m_Format(format)
 {
-    Log.Info("Image create");
 }
 
 VulkanImage::~VulkanImage()
 {
-    vkDestroyImage(m_Device->GetHandle(), m_Image, nullptr);
-    Log.Info("Image destructed");
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), image = m_Image, allocation = m_Allocation, &allocator = m_Device->GetAllocator()]() mutable
+    {
+        vkDestroyImage(device, image, nullptr);
+        allocator.Free(allocation);
+    });
 }
 
 std::shared_ptr<VulkanDevice> VulkanImage::GetDevice() const
@@ -35,4 +37,9 @@ VkExtent2D VulkanImage::GetExtent() const
 VkFormat VulkanImage::GetFormat() const
 {
     return m_Format;
+}
+
+const VulkanAllocation& VulkanImage::GetAllocation() const
+{
+    return m_Allocation;
 }
\ No newline at end of file
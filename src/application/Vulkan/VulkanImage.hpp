@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 class VulkanImage
 {
@@ -13,6 +14,9 @@ public:
     VkExtent2D GetExtent() const;
     VkFormat GetFormat() const;
 
+    // Empty for images owned by someone else, e.g. the swapchain
+    const VulkanAllocation& GetAllocation() const;
+
 protected:
     VulkanImage(std::shared_ptr<VulkanDevice> device, VkImage handle, VkExtent2D extent, VkFormat format);
 
@@ -23,4 +27,8 @@ protected:
 
     VkExtent2D m_Extent;
     VkFormat m_Format;
+
+    VulkanAllocation m_Allocation;
+
+    VulkanObjectTracker<VulkanObjectType::Image> m_Tracker;
 };
\ No newline at end of file
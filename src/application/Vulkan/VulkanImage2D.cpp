@@ -3,4 +3,63 @@
 VulkanImage2D::VulkanImage2D(std::shared_ptr<VulkanDevice> device, VkImage handle, VkFormat format, VkExtent2D extent)
     : VulkanImage(device, handle, extent, format)
 {
-}
\ No newline at end of file
+}
+
+VulkanImage2D::VulkanImage2D
+(
+    std::shared_ptr<VulkanDevice> device,
+    VkFormat format,
+    VkExtent2D extent,
+    VkImageUsageFlags usage,
+    VkMemoryPropertyFlags memoryFlags,
+    VkImageTiling tiling
+) : VulkanImage(device, VK_NULL_HANDLE, extent, format)
+{
+    VkImageCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    createInfo.imageType = VK_IMAGE_TYPE_2D;
+    createInfo.format = format;
+    createInfo.extent = { extent.width, extent.height, 1 };
+    createInfo.mipLevels = 1;
+    createInfo.arrayLayers = 1;
+    createInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    createInfo.tiling = tiling;
+    createInfo.usage = usage;
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VkResult result = vkCreateImage(device->GetHandle(), &createInfo, nullptr, &m_Image);
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error("vkCreateImage failed");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    VulkanAllocationCreateInfo allocationInfo;
+    allocationInfo.RequiredFlags = memoryFlags;
+    allocationInfo.Linear = tiling == VK_IMAGE_TILING_LINEAR;
+
+    m_Allocation = device->GetAllocator().AllocateForImage(m_Image, allocationInfo);
+
+    result = vkBindImageMemory(device->GetHandle(), m_Image, m_Allocation.Memory, m_Allocation.Offset);
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error("vkBindImageMemory failed");
+        throw std::runtime_error("Vulkan error");
+    }
+}
+
+std::shared_ptr<VulkanImage2D> VulkanImage2D::Create
+(
+    std::shared_ptr<VulkanDevice> device,
+    VkFormat format,
+    VkExtent2D extent,
+    VkImageUsageFlags usage,
+    VkMemoryPropertyFlags memoryFlags,
+    VkImageTiling tiling
+)
+{
+    return std::make_shared<VulkanImage2D>(device, format, extent, usage, memoryFlags, tiling);
+}
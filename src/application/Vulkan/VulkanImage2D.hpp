@@ -5,5 +5,25 @@
 class VulkanImage2D : public VulkanImage
 {
 public:
+    // Wraps an image created elsewhere
     VulkanImage2D(std::shared_ptr<VulkanDevice> device, VkImage handle, VkFormat format, VkExtent2D extent);
-};
\ No newline at end of file
+
+    // Creates the image and binds it to memory from the device allocator
+    VulkanImage2D(
+        std::shared_ptr<VulkanDevice> device,
+        VkFormat format,
+        VkExtent2D extent,
+        VkImageUsageFlags usage,
+        VkMemoryPropertyFlags memoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL
+    );
+
+    static std::shared_ptr<VulkanImage2D> Create(
+        std::shared_ptr<VulkanDevice> device,
+        VkFormat format,
+        VkExtent2D extent,
+        VkImageUsageFlags usage,
+        VkMemoryPropertyFlags memoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL
+    );
+};
@@ -31,18 +31,19 @@ VulkanImageView::VulkanImageView(std::shared_ptr<VulkanImage> image, VkComponent
         Log.Error("vkCreateImageView failed");
         throw std::runtime_error("Vulkan error");
     }
-
-    Log.Info("VulkanImageView created");
 }
 
 VulkanImageView::~VulkanImageView()
 {
     if(m_ImageView != VK_NULL_HANDLE)
     {
-        vkDestroyImageView(m_Image->GetDevice()->GetHandle(), m_ImageView, nullptr);
+        std::shared_ptr<VulkanDevice> device = m_Image->GetDevice();
+
+        device->GetDeletionQueue().Enqueue([deviceHandle = device->GetHandle(), imageView = m_ImageView]()
+        {
+            vkDestroyImageView(deviceHandle, imageView, nullptr);
+        });
     }
-    
-    Log.Info("VulkanImageView destructed");
 }
 
 std::shared_ptr<VulkanImageView> VulkanImageView::Create(std::shared_ptr<VulkanImage> image, VkComponentMapping mapping)
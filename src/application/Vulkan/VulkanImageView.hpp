@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 class VulkanSwapchain;
 class VulkanImage;
@@ -38,4 +39,6 @@ public:
 private:
     VkImageView m_ImageView;
     std::shared_ptr<VulkanImage> m_Image;
+
+    VulkanObjectTracker<VulkanObjectType::ImageView> m_Tracker;
 };
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "../debug/Log.hpp"
 
 VulkanInstance::VulkanInstance(const VulkanInstanceCreateInfo& instanceCreateInfo)
-    : m_Instance(nullptr), m_CreateInfo(instanceCreateInfo)
+    : m_Instance(nullptr), m_CreateInfo(instanceCreateInfo), m_ApiVersion(VK_API_VERSION_1_1)
 {        
     VkApplicationInfo appInfo{};
     appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
@@ -11,7 +11,14 @@ VulkanInstance::VulkanInstance(const VulkanInstanceCreateInfo& instanceCreateInf
     appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
     appInfo.pEngineName = "No engine";
     appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    appInfo.apiVersion = VK_API_VERSION_1_1;
+
+    // 1.2 brings timeline semaphores into core, older loaders only accept up to 1.1
+    uint32_t loaderVersion = VK_API_VERSION_1_0;
+    if(vkEnumerateInstanceVersion(&loaderVersion) != VK_SUCCESS)
+        loaderVersion = VK_API_VERSION_1_0;
+
+    m_ApiVersion = loaderVersion >= VK_API_VERSION_1_2 ? VK_API_VERSION_1_2 : VK_API_VERSION_1_1;
+    appInfo.apiVersion = m_ApiVersion;
 
     auto properties = EnumerateExtensions();
     Log.Info("Available Vulkan extensions [", properties.size(), "]:");
@@ -65,26 +72,17 @@ VulkanInstance::VulkanInstance(const VulkanInstanceCreateInfo& instanceCreateInf
 
     for(auto ext : instanceCreateInfo.ValidationLayers)
         EnabledLayers.insert(ext);
-
-    Log.Info("Created Vulkan instance");
     
-    uint32_t apiVersion;
-    if(vkEnumerateInstanceVersion(&apiVersion) != VK_SUCCESS)
-    {
-        Log.Error("Failed to retrieve Vulkan api version");
-    }
-    else
-    {
-        Log.Info("Using Vulkan api version ", 
-        VK_API_VERSION_MAJOR(apiVersion), ".",
-        VK_API_VERSION_MINOR(apiVersion), ".",
-        VK_API_VERSION_PATCH(apiVersion));
-    }
+    Log.Info("Using Vulkan api version ", 
+        VK_API_VERSION_MAJOR(m_ApiVersion), ".",
+        VK_API_VERSION_MINOR(m_ApiVersion), " on loader ",
+        VK_API_VERSION_MAJOR(loaderVersion), ".",
+        VK_API_VERSION_MINOR(loaderVersion), ".",
+        VK_API_VERSION_PATCH(loaderVersion));
 }
 
 VulkanInstance::~VulkanInstance()
 {
-    Log.Info("Destructed VulkanInstance");
     vkDestroyInstance(m_Instance, nullptr);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanPhysicalDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 #include <vulkan/vulkan.hpp>
 #include <SDL3/SDL_vulkan.h>
@@ -35,6 +36,9 @@ public:
 
     VkInstance GetInstance() const;
 
+    // Version requested at creation, device level features above it can't be used
+    uint32_t GetApiVersion() const { return m_ApiVersion; }
+
     bool Debugging() const 
     {
         return m_CreateInfo.EnableValidationLayers;
@@ -56,6 +60,7 @@ private:
 private:
     VkInstance m_Instance;
     VulkanInstanceCreateInfo m_CreateInfo;
+    uint32_t m_ApiVersion;
 
     // List of all supported extensions
     std::set<const char*> Extensions;
@@ -65,4 +70,6 @@ private:
     
     // List of enabled validation layers
     std::set<const char*> EnabledLayers;
+
+    VulkanObjectTracker<VulkanObjectType::Instance> m_Tracker;
 };
\ No newline at end of file
@@ -0,0 +1,533 @@
+#include "VulkanMemoryAllocator.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+
+VulkanMemoryBlock::VulkanMemoryBlock(VkDevice device, uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize size, bool hostVisible)
+    : m_Device(device), m_Memory(memory), m_Size(size), m_MemoryTypeIndex(memoryTypeIndex), m_MappedData(nullptr), m_AllocationCount(0)
+{
+    // Host visible blocks stay mapped for their whole lifetime so allocations never call vkMapMemory
+    if(hostVisible)
+    {
+        VkResult result = vkMapMemory(m_Device, m_Memory, 0, VK_WHOLE_SIZE, 0, &m_MappedData);
+
+        if(result != VK_SUCCESS)
+        {
+            Log.Error("Failed to map memory block");
+            vkFreeMemory(m_Device, m_Memory, nullptr);
+            throw std::runtime_error("Vulkan error");
+        }
+    }
+
+    uint32_t levelCount = SizeToLevel(MinNodeSize) + 1;
+    m_FreeNodes.resize(levelCount);
+    m_FreeNodes[0].insert(0);
+}
+
+VulkanMemoryBlock::~VulkanMemoryBlock()
+{
+    // vkFreeMemory implicitly unmaps the memory
+    vkFreeMemory(m_Device, m_Memory, nullptr);
+}
+
+bool VulkanMemoryBlock::Allocate(VkDeviceSize size, VkDeviceSize alignment, VulkanAllocation& allocation)
+{
+    // Nodes are aligned to their own size so rounding up to the alignment is enough
+    VkDeviceSize nodeSize = std::bit_ceil(std::max({ size, alignment, MinNodeSize }));
+
+    if(nodeSize > m_Size)
+        return false;
+
+    const uint32_t targetLevel = SizeToLevel(nodeSize);
+
+    // Find the smallest free node that can hold the allocation
+    int32_t level = static_cast<int32_t>(targetLevel);
+    while(level >= 0 && m_FreeNodes[level].empty())
+        level--;
+
+    if(level < 0)
+        return false;
+
+    VkDeviceSize offset = *m_FreeNodes[level].begin();
+    m_FreeNodes[level].erase(m_FreeNodes[level].begin());
+
+    // Split until the node is the right size, the upper halves go to the free lists
+    while(static_cast<uint32_t>(level) < targetLevel)
+    {
+        level++;
+        m_FreeNodes[level].insert(offset + LevelToSize(level));
+    }
+
+    m_Allocations[offset] = { targetLevel, size };
+    m_AllocationCount++;
+
+    allocation.Memory = m_Memory;
+    allocation.Offset = offset;
+    allocation.Size = size;
+    allocation.MemoryTypeIndex = m_MemoryTypeIndex;
+    allocation.MappedData = m_MappedData ? static_cast<char*>(m_MappedData) + offset : nullptr;
+    allocation.Block = this;
+
+    return true;
+}
+
+void VulkanMemoryBlock::Free(const VulkanAllocation& allocation)
+{
+    auto it = m_Allocations.find(allocation.Offset);
+
+    if(it == m_Allocations.end())
+    {
+        Log.Error("Tried to free an allocation not owned by the memory block");
+        return;
+    }
+
+    uint32_t level = it->second.first;
+    VkDeviceSize offset = it->first;
+
+    m_Allocations.erase(it);
+    m_AllocationCount--;
+
+    // Merge with the buddy for as long as it is free
+    while(level > 0)
+    {
+        VkDeviceSize buddy = offset ^ LevelToSize(level);
+        auto buddyIt = m_FreeNodes[level].find(buddy);
+
+        if(buddyIt == m_FreeNodes[level].end())
+            break;
+
+        m_FreeNodes[level].erase(buddyIt);
+        offset = std::min(offset, buddy);
+        level--;
+    }
+
+    m_FreeNodes[level].insert(offset);
+}
+
+void VulkanMemoryBlock::AccumulateStats(VulkanMemoryStats& stats) const
+{
+    stats.BlockCount++;
+    stats.AllocationCount += m_AllocationCount;
+    stats.BytesAllocated += m_Size;
+
+    for(auto& [offset, allocation] : m_Allocations)
+    {
+        auto& [level, size] = allocation;
+        stats.BytesUsed += size;
+        stats.BytesWasted += LevelToSize(level) - size;
+    }
+
+    VkDeviceSize bytesFree = 0;
+    VkDeviceSize largestRange = 0;
+    GetFreeRanges(bytesFree, largestRange);
+
+    stats.LargestFreeRange = std::max(stats.LargestFreeRange, largestRange);
+}
+
+void VulkanMemoryBlock::GetFreeRanges(VkDeviceSize& bytesFree, VkDeviceSize& largestRange) const
+{
+    bytesFree = 0;
+    largestRange = 0;
+
+    // Neighbouring free nodes which aren't buddies still form one contiguous range
+    std::vector<std::pair<VkDeviceSize, VkDeviceSize>> freeNodes;
+    for(uint32_t level = 0; level < m_FreeNodes.size(); level++)
+    {
+        for(VkDeviceSize offset : m_FreeNodes[level])
+            freeNodes.emplace_back(offset, LevelToSize(level));
+    }
+
+    std::sort(freeNodes.begin(), freeNodes.end());
+
+    VkDeviceSize rangeEnd = 0;
+    VkDeviceSize rangeSize = 0;
+    for(auto& [offset, size] : freeNodes)
+    {
+        rangeSize = (offset == rangeEnd) ? rangeSize + size : size;
+        rangeEnd = offset + size;
+        bytesFree += size;
+        largestRange = std::max(largestRange, rangeSize);
+    }
+}
+
+uint32_t VulkanMemoryBlock::SizeToLevel(VkDeviceSize size) const
+{
+    uint32_t level = 0;
+    while(LevelToSize(level + 1) >= size && LevelToSize(level + 1) >= MinNodeSize)
+        level++;
+
+    return level;
+}
+
+VulkanMemoryAllocator::VulkanMemoryAllocator(VkDevice device, std::shared_ptr<VulkanPhysicalDevice> physicalDevice, VkDeviceSize preferredBlockSize)
+    : m_Device(device), m_PhysicalDevice(physicalDevice), m_PreferredBlockSize(std::bit_floor(preferredBlockSize))
+{
+    m_MemoryProperties = physicalDevice->GetMemoryProperties();
+
+    const VkPhysicalDeviceLimits& limits = physicalDevice->GetProperties().limits;
+    m_BufferImageGranularity = limits.bufferImageGranularity;
+    m_NonCoherentAtomSize = limits.nonCoherentAtomSize;
+
+    // vkGet*MemoryRequirements2 and dedicated allocations are core since 1.1
+    m_HasDedicatedAllocation = physicalDevice->GetProperties().apiVersion >= VK_API_VERSION_1_1;
+}
+
+VulkanMemoryAllocator::~VulkanMemoryAllocator()
+{
+    VulkanMemoryStats stats = GetStats();
+
+    if(stats.AllocationCount > 0 || stats.DedicatedAllocationCount > 0)
+    {
+        Log.Warn("MemoryAllocator destructed with ", stats.AllocationCount + stats.DedicatedAllocationCount, " live allocations");
+    }
+
+    for(auto& [memory, size] : m_DedicatedAllocations)
+    {
+        vkFreeMemory(m_Device, memory, nullptr);
+    }
+
+    m_Pools.clear();
+}
+
+VulkanAllocation VulkanMemoryAllocator::AllocateForBuffer(VkBuffer buffer, const VulkanAllocationCreateInfo& createInfo)
+{
+    if(!m_HasDedicatedAllocation)
+    {
+        VkMemoryRequirements requirements;
+        vkGetBufferMemoryRequirements(m_Device, buffer, &requirements);
+
+        return Allocate(requirements, createInfo, false, buffer, VK_NULL_HANDLE);
+    }
+
+    VkMemoryDedicatedRequirements dedicatedRequirements{};
+    dedicatedRequirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    requirements.pNext = &dedicatedRequirements;
+
+    VkBufferMemoryRequirementsInfo2 requirementsInfo{};
+    requirementsInfo.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+    requirementsInfo.buffer = buffer;
+
+    vkGetBufferMemoryRequirements2(m_Device, &requirementsInfo, &requirements);
+
+    bool driverWantsDedicated = dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation;
+
+    return Allocate(requirements.memoryRequirements, createInfo, driverWantsDedicated, buffer, VK_NULL_HANDLE);
+}
+
+VulkanAllocation VulkanMemoryAllocator::AllocateForImage(VkImage image, const VulkanAllocationCreateInfo& createInfo)
+{
+    if(!m_HasDedicatedAllocation)
+    {
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(m_Device, image, &requirements);
+
+        return Allocate(requirements, createInfo, false, VK_NULL_HANDLE, image);
+    }
+
+    VkMemoryDedicatedRequirements dedicatedRequirements{};
+    dedicatedRequirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    requirements.pNext = &dedicatedRequirements;
+
+    VkImageMemoryRequirementsInfo2 requirementsInfo{};
+    requirementsInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+    requirementsInfo.image = image;
+
+    vkGetImageMemoryRequirements2(m_Device, &requirementsInfo, &requirements);
+
+    bool driverWantsDedicated = dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation;
+
+    return Allocate(requirements.memoryRequirements, createInfo, driverWantsDedicated, VK_NULL_HANDLE, image);
+}
+
+void VulkanMemoryAllocator::Free(VulkanAllocation& allocation)
+{
+    if(allocation.Memory == VK_NULL_HANDLE)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if(allocation.Block == nullptr)
+    {
+        m_DedicatedAllocations.erase(allocation.Memory);
+        vkFreeMemory(m_Device, allocation.Memory, nullptr);
+    }
+    else
+    {
+        VulkanMemoryBlock* block = allocation.Block;
+        block->Free(allocation);
+
+        // Release empty blocks but keep the last one of a pool around to avoid churn
+        for(auto& [poolKey, blocks] : m_Pools)
+        {
+            if(!block->IsEmpty() || blocks.size() < 2)
+                continue;
+
+            auto it = std::find_if(blocks.begin(), blocks.end(), [block](const auto& b) { return b.get() == block; });
+
+            if(it != blocks.end())
+            {
+                blocks.erase(it);
+                break;
+            }
+        }
+    }
+
+    allocation = VulkanAllocation{};
+}
+
+void VulkanMemoryAllocator::Flush(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size)
+{
+    FlushOrInvalidate(allocation, offset, size, true);
+}
+
+void VulkanMemoryAllocator::Invalidate(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size)
+{
+    FlushOrInvalidate(allocation, offset, size, false);
+}
+
+bool VulkanMemoryAllocator::IsHostCoherent(const VulkanAllocation& allocation) const
+{
+    return m_MemoryProperties.memoryTypes[allocation.MemoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+}
+
+VulkanMemoryStats VulkanMemoryAllocator::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    VulkanMemoryStats stats;
+
+    // A largest range from one block against free bytes summed over all of them would call two empty blocks fragmented
+    double weightedFragmentation = 0.0;
+    VkDeviceSize blockBytesFree = 0;
+
+    for(auto& [poolKey, blocks] : m_Pools)
+    {
+        for(auto& block : blocks)
+        {
+            block->AccumulateStats(stats);
+
+            VkDeviceSize bytesFree = 0;
+            VkDeviceSize largestRange = 0;
+            block->GetFreeRanges(bytesFree, largestRange);
+
+            if(bytesFree > 0)
+            {
+                weightedFragmentation += (1.0 - static_cast<double>(largestRange) / static_cast<double>(bytesFree)) * bytesFree;
+                blockBytesFree += bytesFree;
+            }
+        }
+    }
+
+    for(auto& [memory, size] : m_DedicatedAllocations)
+    {
+        stats.DedicatedAllocationCount++;
+        stats.BytesAllocated += size;
+        stats.BytesUsed += size;
+    }
+
+    if(blockBytesFree > 0)
+        stats.Fragmentation = static_cast<float>(weightedFragmentation / blockBytesFree);
+
+    return stats;
+}
+
+void VulkanMemoryAllocator::LogStats() const
+{
+    VulkanMemoryStats stats = GetStats();
+
+    Log.Info("Device memory: ",
+        stats.BlockCount, " blocks, ",
+        stats.AllocationCount, " sub-allocations, ",
+        stats.DedicatedAllocationCount, " dedicated allocations, ",
+        stats.BytesAllocated / 1024, " KiB allocated, ",
+        stats.BytesUsed / 1024, " KiB used, ",
+        stats.BytesWasted / 1024, " KiB wasted, ",
+        "fragmentation ", stats.Fragmentation
+    );
+}
+
+VulkanAllocation VulkanMemoryAllocator::Allocate(const VkMemoryRequirements& requirements, const VulkanAllocationCreateInfo& createInfo, bool driverWantsDedicated, VkBuffer buffer, VkImage image)
+{
+    std::vector<uint32_t> memoryTypes = FindMemoryTypes(requirements.memoryTypeBits, createInfo);
+
+    if(memoryTypes.empty())
+    {
+        Log.Error("No memory type satisfies the allocation requirements");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Fall through to the next suitable memory type when a heap runs out
+    for(uint32_t memoryTypeIndex : memoryTypes)
+    {
+        bool dedicated = createInfo.Dedicated || driverWantsDedicated || requirements.size > GetBlockSize(memoryTypeIndex) / 2;
+
+        VulkanAllocation allocation = dedicated
+            ? AllocateDedicated(requirements, memoryTypeIndex, buffer, image)
+            : AllocateFromBlocks(requirements, memoryTypeIndex, createInfo.Linear);
+
+        if(allocation.Memory != VK_NULL_HANDLE)
+            return allocation;
+    }
+
+    Log.Error("Out of device memory");
+    throw std::runtime_error("Vulkan error");
+}
+
+VulkanAllocation VulkanMemoryAllocator::AllocateDedicated(const VkMemoryRequirements& requirements, uint32_t memoryTypeIndex, VkBuffer buffer, VkImage image)
+{
+    VkMemoryDedicatedAllocateInfo dedicatedInfo{};
+    dedicatedInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+    dedicatedInfo.buffer = buffer;
+    dedicatedInfo.image = image;
+
+    VkMemoryAllocateInfo allocateInfo{};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.pNext = m_HasDedicatedAllocation ? &dedicatedInfo : nullptr;
+    allocateInfo.allocationSize = requirements.size;
+    allocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+    VulkanAllocation allocation;
+
+    VkResult result = vkAllocateMemory(m_Device, &allocateInfo, nullptr, &allocation.Memory);
+
+    if(result != VK_SUCCESS)
+        return VulkanAllocation{};
+
+    allocation.Offset = 0;
+    allocation.Size = requirements.size;
+    allocation.MemoryTypeIndex = memoryTypeIndex;
+
+    if(IsHostVisible(memoryTypeIndex))
+    {
+        result = vkMapMemory(m_Device, allocation.Memory, 0, VK_WHOLE_SIZE, 0, &allocation.MappedData);
+
+        if(result != VK_SUCCESS)
+        {
+            vkFreeMemory(m_Device, allocation.Memory, nullptr);
+            return VulkanAllocation{};
+        }
+    }
+
+    m_DedicatedAllocations[allocation.Memory] = requirements.size;
+
+    return allocation;
+}
+
+VulkanAllocation VulkanMemoryAllocator::AllocateFromBlocks(const VkMemoryRequirements& requirements, uint32_t memoryTypeIndex, bool linear)
+{
+    // Resources of different tiling never share a block so bufferImageGranularity can't be violated
+    uint32_t poolKey = memoryTypeIndex * 2 + ((m_BufferImageGranularity > 1 && !linear) ? 1 : 0);
+    auto& blocks = m_Pools[poolKey];
+
+    VulkanAllocation allocation;
+
+    for(auto& block : blocks)
+    {
+        if(block->Allocate(requirements.size, requirements.alignment, allocation))
+            return allocation;
+    }
+
+    VkMemoryAllocateInfo allocateInfo{};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.allocationSize = GetBlockSize(memoryTypeIndex);
+    allocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+    VkDeviceMemory memory;
+    VkResult result = vkAllocateMemory(m_Device, &allocateInfo, nullptr, &memory);
+
+    if(result != VK_SUCCESS)
+        return VulkanAllocation{};
+
+    blocks.emplace_back(std::make_unique<VulkanMemoryBlock>(m_Device, memoryTypeIndex, memory, allocateInfo.allocationSize, IsHostVisible(memoryTypeIndex)));
+
+    LOG_DEBUG(VulkanLifetime, "Allocated memory block of ", allocateInfo.allocationSize / 1024, " KiB for memory type ", memoryTypeIndex);
+
+    if(!blocks.back()->Allocate(requirements.size, requirements.alignment, allocation))
+        return VulkanAllocation{};
+
+    return allocation;
+}
+
+std::vector<uint32_t> VulkanMemoryAllocator::FindMemoryTypes(uint32_t typeBits, const VulkanAllocationCreateInfo& createInfo) const
+{
+    std::vector<uint32_t> result;
+
+    for(uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++)
+    {
+        VkMemoryPropertyFlags flags = m_MemoryProperties.memoryTypes[i].propertyFlags;
+
+        if((typeBits & (1u << i)) && (flags & createInfo.RequiredFlags) == createInfo.RequiredFlags)
+            result.push_back(i);
+    }
+
+    // Most preferred flags first, then fewest flags nobody asked for
+    auto score = [&](uint32_t index)
+    {
+        VkMemoryPropertyFlags flags = m_MemoryProperties.memoryTypes[index].propertyFlags;
+        VkMemoryPropertyFlags unwanted = flags & ~(createInfo.RequiredFlags | createInfo.PreferredFlags);
+
+        return std::popcount(flags & createInfo.PreferredFlags) * 32 - std::popcount(unwanted);
+    };
+
+    std::stable_sort(result.begin(), result.end(), [&](uint32_t a, uint32_t b) { return score(a) > score(b); });
+
+    return result;
+}
+
+VkDeviceSize VulkanMemoryAllocator::GetBlockSize(uint32_t memoryTypeIndex) const
+{
+    uint32_t heapIndex = m_MemoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+    VkDeviceSize heapSize = m_MemoryProperties.memoryHeaps[heapIndex].size;
+
+    // Small heaps (e.g. the 256 MiB BAR heap) would be exhausted by a few full size blocks
+    if(heapSize <= 1024ull * 1024 * 1024)
+        return std::min(m_PreferredBlockSize, std::bit_floor(heapSize / 8));
+
+    return m_PreferredBlockSize;
+}
+
+bool VulkanMemoryAllocator::IsHostVisible(uint32_t memoryTypeIndex) const
+{
+    return m_MemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+}
+
+void VulkanMemoryAllocator::FlushOrInvalidate(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size, bool flush)
+{
+    if(allocation.Memory == VK_NULL_HANDLE || IsHostCoherent(allocation))
+        return;
+
+    if(size == VK_WHOLE_SIZE)
+        size = allocation.Size - offset;
+
+    VkDeviceSize memorySize = allocation.Block ? allocation.Block->GetSize() : allocation.Size;
+    VkDeviceSize begin = allocation.Offset + offset;
+    VkDeviceSize end = begin + size;
+
+    begin = begin / m_NonCoherentAtomSize * m_NonCoherentAtomSize;
+    end = (end + m_NonCoherentAtomSize - 1) / m_NonCoherentAtomSize * m_NonCoherentAtomSize;
+
+    VkMappedMemoryRange range{};
+    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.memory = allocation.Memory;
+    range.offset = begin;
+    range.size = end >= memorySize ? VK_WHOLE_SIZE : end - begin;
+
+    VkResult result = flush
+        ? vkFlushMappedMemoryRanges(m_Device, 1, &range)
+        : vkInvalidateMappedMemoryRanges(m_Device, 1, &range);
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error(flush ? "vkFlushMappedMemoryRanges failed" : "vkInvalidateMappedMemoryRanges failed");
+        throw std::runtime_error("Vulkan error");
+    }
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "VulkanPhysicalDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+#include <Vulkan/vulkan.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+struct VulkanAllocationCreateInfo
+{
+    // Memory type has to support all of these
+    VkMemoryPropertyFlags RequiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    // Memory types supporting more of these are picked first
+    VkMemoryPropertyFlags PreferredFlags = 0;
+
+    // Buffers and linearly tiled images have to be kept apart from optimally tiled
+    // images when bufferImageGranularity is larger than 1
+    bool Linear = true;
+
+    // Skip the sub-allocator and give the resource its own VkDeviceMemory
+    bool Dedicated = false;
+};
+
+class VulkanMemoryBlock;
+
+struct VulkanAllocation
+{
+    VkDeviceMemory Memory = VK_NULL_HANDLE;
+    VkDeviceSize Offset = 0;
+    VkDeviceSize Size = 0;
+    uint32_t MemoryTypeIndex = 0;
+
+    // Points into the persistently mapped block, nullptr if memory is not host visible
+    void* MappedData = nullptr;
+
+    // nullptr for dedicated allocations
+    VulkanMemoryBlock* Block = nullptr;
+};
+
+struct VulkanMemoryStats
+{
+    uint32_t BlockCount = 0;
+    uint32_t DedicatedAllocationCount = 0;
+    uint32_t AllocationCount = 0;
+
+    // Bytes requested from the driver through vkAllocateMemory
+    VkDeviceSize BytesAllocated = 0;
+
+    // Bytes handed out to resources (requested sizes)
+    VkDeviceSize BytesUsed = 0;
+
+    // Bytes lost to power of two rounding and alignment inside the blocks
+    VkDeviceSize BytesWasted = 0;
+
+    VkDeviceSize LargestFreeRange = 0;
+
+    // Per block 0 when its free memory is one contiguous range, approaching 1 as it gets split up.
+    // Averaged over the blocks weighted by their free bytes, so empty blocks count as unfragmented
+    float Fragmentation = 0.0f;
+};
+
+// Buddy allocator over a single VkDeviceMemory. Block size has to be a power of two
+class VulkanMemoryBlock
+{
+public:
+    // Takes ownership of |memory|
+    VulkanMemoryBlock(VkDevice device, uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize size, bool hostVisible);
+    ~VulkanMemoryBlock();
+
+    VulkanMemoryBlock(const VulkanMemoryBlock&) = delete;
+    VulkanMemoryBlock& operator=(const VulkanMemoryBlock&) = delete;
+
+    // Returns false if the block doesn't have a large enough free range
+    bool Allocate(VkDeviceSize size, VkDeviceSize alignment, VulkanAllocation& allocation);
+    void Free(const VulkanAllocation& allocation);
+
+    bool IsEmpty() const { return m_AllocationCount == 0; }
+
+    VkDeviceMemory GetHandle() const { return m_Memory; }
+    VkDeviceSize GetSize() const { return m_Size; }
+    uint32_t GetMemoryTypeIndex() const { return m_MemoryTypeIndex; }
+    void* GetMappedData() const { return m_MappedData; }
+
+    void AccumulateStats(VulkanMemoryStats& stats) const;
+
+    // Total size of the free nodes and the largest contiguous range they form
+    void GetFreeRanges(VkDeviceSize& bytesFree, VkDeviceSize& largestRange) const;
+
+public:
+    static constexpr VkDeviceSize MinNodeSize = 256;
+
+private:
+    uint32_t SizeToLevel(VkDeviceSize size) const;
+    VkDeviceSize LevelToSize(uint32_t level) const { return m_Size >> level; }
+
+private:
+    VkDevice m_Device;
+    VkDeviceMemory m_Memory;
+    VkDeviceSize m_Size;
+    uint32_t m_MemoryTypeIndex;
+    void* m_MappedData;
+
+    // Level 0 is the whole block, every level below halves the node size
+    std::vector<std::set<VkDeviceSize>> m_FreeNodes;
+
+    // Offset -> level and requested size of each live allocation
+    std::map<VkDeviceSize, std::pair<uint32_t, VkDeviceSize>> m_Allocations;
+
+    uint32_t m_AllocationCount;
+};
+
+class VulkanMemoryAllocator
+{
+public:
+    VulkanMemoryAllocator(VkDevice device, std::shared_ptr<VulkanPhysicalDevice> physicalDevice, VkDeviceSize preferredBlockSize = DefaultBlockSize);
+    ~VulkanMemoryAllocator();
+
+    VulkanMemoryAllocator(const VulkanMemoryAllocator&) = delete;
+    VulkanMemoryAllocator& operator=(const VulkanMemoryAllocator&) = delete;
+
+    // Allocations have to be bound by the caller using Memory and Offset
+    VulkanAllocation AllocateForBuffer(VkBuffer buffer, const VulkanAllocationCreateInfo& createInfo);
+    VulkanAllocation AllocateForImage(VkImage image, const VulkanAllocationCreateInfo& createInfo);
+
+    void Free(VulkanAllocation& allocation);
+
+    // Ranges are expanded to nonCoherentAtomSize. Both are no-ops on coherent memory
+    void Flush(const VulkanAllocation& allocation, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+    void Invalidate(const VulkanAllocation& allocation, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+    bool IsHostCoherent(const VulkanAllocation& allocation) const;
+
+    VulkanMemoryStats GetStats() const;
+    void LogStats() const;
+
+public:
+    static constexpr VkDeviceSize DefaultBlockSize = 64ull * 1024 * 1024;
+
+private:
+    VulkanAllocation Allocate(const VkMemoryRequirements& requirements, const VulkanAllocationCreateInfo& createInfo, bool driverWantsDedicated, VkBuffer buffer, VkImage image);
+
+    VulkanAllocation AllocateDedicated(const VkMemoryRequirements& requirements, uint32_t memoryTypeIndex, VkBuffer buffer, VkImage image);
+    VulkanAllocation AllocateFromBlocks(const VkMemoryRequirements& requirements, uint32_t memoryTypeIndex, bool linear);
+
+    // Memory type indices allowed by |typeBits| having |RequiredFlags|, best match first
+    std::vector<uint32_t> FindMemoryTypes(uint32_t typeBits, const VulkanAllocationCreateInfo& createInfo) const;
+
+    VkDeviceSize GetBlockSize(uint32_t memoryTypeIndex) const;
+    bool IsHostVisible(uint32_t memoryTypeIndex) const;
+
+    void FlushOrInvalidate(const VulkanAllocation& allocation, VkDeviceSize offset, VkDeviceSize size, bool flush);
+
+private:
+    VkDevice m_Device;
+    std::shared_ptr<VulkanPhysicalDevice> m_PhysicalDevice;
+
+    VkPhysicalDeviceMemoryProperties m_MemoryProperties;
+    VkDeviceSize m_BufferImageGranularity;
+    VkDeviceSize m_NonCoherentAtomSize;
+    VkDeviceSize m_PreferredBlockSize;
+    bool m_HasDedicatedAllocation;
+
+    // Pools are keyed by memory type index and, when granularity matters, linear/optimal tiling
+    std::map<uint32_t, std::vector<std::unique_ptr<VulkanMemoryBlock>>> m_Pools;
+
+    // Dedicated allocation -> requested size
+    std::map<VkDeviceMemory, VkDeviceSize> m_DedicatedAllocations;
+
+    mutable std::mutex m_Mutex;
+
+    VulkanObjectTracker<VulkanObjectType::MemoryAllocator> m_Tracker;
+};
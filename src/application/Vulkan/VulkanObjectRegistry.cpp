@@ -0,0 +1,184 @@
+#include "VulkanObjectRegistry.hpp"
+#include "../debug/Log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+
+static thread_local const VulkanObjectScope* s_CurrentScope = nullptr;
+
+const char* ToString(VulkanObjectType type)
+{
+    switch(type)
+    {
+        case VulkanObjectType::Instance: return "Instance";
+        case VulkanObjectType::DebugMessenger: return "DebugMessenger";
+        case VulkanObjectType::PhysicalDevice: return "PhysicalDevice";
+        case VulkanObjectType::Device: return "Device";
+        case VulkanObjectType::Queue: return "Queue";
+        case VulkanObjectType::MemoryAllocator: return "MemoryAllocator";
+        case VulkanObjectType::UploadRing: return "UploadRing";
+        case VulkanObjectType::Fence: return "Fence";
+        case VulkanObjectType::Semaphore: return "Semaphore";
+        case VulkanObjectType::TimelineSemaphore: return "TimelineSemaphore";
+        case VulkanObjectType::CommandPool: return "CommandPool";
+        case VulkanObjectType::CommandBuffer: return "CommandBuffer";
+        case VulkanObjectType::Buffer: return "Buffer";
+        case VulkanObjectType::Image: return "Image";
+        case VulkanObjectType::ImageView: return "ImageView";
+        case VulkanObjectType::Swapchain: return "Swapchain";
+        case VulkanObjectType::RenderPass: return "RenderPass";
+        case VulkanObjectType::Framebuffer: return "Framebuffer";
+        case VulkanObjectType::ShaderModule: return "ShaderModule";
+        case VulkanObjectType::PipelineLayout: return "PipelineLayout";
+        case VulkanObjectType::Pipeline: return "Pipeline";
+        case VulkanObjectType::PipelineCache: return "PipelineCache";
+        case VulkanObjectType::PipelineLibrary: return "PipelineLibrary";
+        case VulkanObjectType::PipelineCompiler: return "PipelineCompiler";
+        case VulkanObjectType::QueryPool: return "QueryPool";
+        case VulkanObjectType::GpuProfiler: return "GpuProfiler";
+        case VulkanObjectType::FrameContextRing: return "FrameContextRing";
+        case VulkanObjectType::OffscreenTarget: return "OffscreenTarget";
+        case VulkanObjectType::CommandRecorder: return "CommandRecorder";
+        case VulkanObjectType::Count: break;
+    }
+
+    return "Unknown";
+}
+
+// Source paths are absolute, the file name is enough to find the scope. MSVC paths use backslashes
+static const char* StripDirectory(const char* path)
+{
+    const char* slash = std::strrchr(path, '/');
+    const char* backslash = std::strrchr(path, '\\');
+    const char* separator = std::max(slash, backslash, std::less<const char*>());
+
+    return separator ? separator + 1 : path;
+}
+
+VulkanObjectScope::VulkanObjectScope(const char* name, std::source_location location)
+    : m_Name(name), m_Location(location), m_Parent(s_CurrentScope)
+{
+    s_CurrentScope = this;
+}
+
+VulkanObjectScope::~VulkanObjectScope()
+{
+    s_CurrentScope = m_Parent;
+}
+
+const VulkanObjectScope* VulkanObjectScope::GetCurrent()
+{
+    return s_CurrentScope;
+}
+
+VulkanObjectRegistry& VulkanObjectRegistry::Get()
+{
+    static VulkanObjectRegistry registry;
+    return registry;
+}
+
+VulkanObjectRegistry::VulkanObjectRegistry()
+    : m_Epoch(std::chrono::steady_clock::now()), m_NextId(1)
+{
+}
+
+uint64_t VulkanObjectRegistry::OnCreated(VulkanObjectType type)
+{
+    TypeCounters& counters = m_Counters[static_cast<size_t>(type)];
+
+    counters.Created.fetch_add(1, std::memory_order_relaxed);
+    uint64_t live = counters.Live.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    uint64_t peak = counters.Peak.load(std::memory_order_relaxed);
+    while(live > peak && !counters.Peak.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+
+    LiveObject object;
+    object.Type = type;
+    object.ScopeName = "unscoped";
+    object.File = "";
+    object.Line = 0;
+    object.CreationTime = std::chrono::steady_clock::now();
+
+    if(const VulkanObjectScope* scope = VulkanObjectScope::GetCurrent())
+    {
+        object.ScopeName = scope->GetName();
+        object.File = StripDirectory(scope->GetLocation().file_name());
+        object.Line = scope->GetLocation().line();
+    }
+
+    uint64_t id = m_NextId.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard lock(m_Mutex);
+    m_LiveObjects.emplace(id, object);
+
+    return id;
+}
+
+void VulkanObjectRegistry::OnDestroyed(VulkanObjectType type, uint64_t id)
+{
+    m_Counters[static_cast<size_t>(type)].Live.fetch_sub(1, std::memory_order_relaxed);
+
+    std::lock_guard lock(m_Mutex);
+    m_LiveObjects.erase(id);
+}
+
+VulkanObjectCounters VulkanObjectRegistry::GetCounters(VulkanObjectType type) const
+{
+    const TypeCounters& counters = m_Counters[static_cast<size_t>(type)];
+
+    VulkanObjectCounters result;
+    result.Live = counters.Live.load(std::memory_order_relaxed);
+    result.Created = counters.Created.load(std::memory_order_relaxed);
+    result.Peak = counters.Peak.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+uint64_t VulkanObjectRegistry::GetLiveCount() const
+{
+    uint64_t live = 0;
+
+    for(const TypeCounters& counters : m_Counters)
+        live += counters.Live.load(std::memory_order_relaxed);
+
+    return live;
+}
+
+void VulkanObjectRegistry::LogCounters() const
+{
+    LOG_INFO(VulkanLifetime, "Vulkan objects, live / created / peak:");
+
+    for(uint32_t i = 0; i < static_cast<uint32_t>(VulkanObjectType::Count); i++)
+    {
+        VulkanObjectType type = static_cast<VulkanObjectType>(i);
+        VulkanObjectCounters counters = GetCounters(type);
+
+        if(counters.Created == 0)
+            continue;
+
+        LOG_INFO(VulkanLifetime, "    ", ToString(type), " ", counters.Live, " / ", counters.Created, " / ", counters.Peak);
+    }
+}
+
+void VulkanObjectRegistry::LogLiveObjects() const
+{
+    std::lock_guard lock(m_Mutex);
+
+    LOG_INFO(VulkanLifetime, m_LiveObjects.size(), " live Vulkan objects");
+
+    auto now = std::chrono::steady_clock::now();
+
+    for(const auto& [id, object] : m_LiveObjects)
+    {
+        double created = std::chrono::duration<double>(object.CreationTime - m_Epoch).count();
+        double age = std::chrono::duration<double>(now - object.CreationTime).count();
+
+        std::string site = object.ScopeName;
+        if(object.Line)
+            site += " (" + std::string(object.File) + ":" + std::to_string(object.Line) + ")";
+
+        LOG_INFO(VulkanLifetime, "    #", id, " ", ToString(object.Type), " from ", site, " at ", created, " s, alive ", age, " s");
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <source_location>
+
+enum class VulkanObjectType : uint32_t
+{
+    Instance,
+    DebugMessenger,
+    PhysicalDevice,
+    Device,
+    Queue,
+    MemoryAllocator,
+    UploadRing,
+    Fence,
+    Semaphore,
+    TimelineSemaphore,
+    CommandPool,
+    CommandBuffer,
+    Buffer,
+    Image,
+    ImageView,
+    Swapchain,
+    RenderPass,
+    Framebuffer,
+    ShaderModule,
+    PipelineLayout,
+    Pipeline,
+    PipelineCache,
+    PipelineLibrary,
+    PipelineCompiler,
+    QueryPool,
+    GpuProfiler,
+    FrameContextRing,
+    OffscreenTarget,
+    CommandRecorder,
+
+    Count
+};
+
+const char* ToString(VulkanObjectType type);
+
+struct VulkanObjectCounters
+{
+    uint64_t Live = 0;
+    uint64_t Created = 0;
+
+    // Highest live count seen
+    uint64_t Peak = 0;
+};
+
+// Names the code creating objects. Objects record the innermost scope active on their thread when they're created,
+// which is what tells a swapchain recreation's image views apart from the initial ones in the live object dump
+class VulkanObjectScope
+{
+public:
+    VulkanObjectScope(const char* name, std::source_location location = std::source_location::current());
+    ~VulkanObjectScope();
+
+    VulkanObjectScope(const VulkanObjectScope&) = delete;
+    VulkanObjectScope& operator=(const VulkanObjectScope&) = delete;
+
+    // nullptr outside of any scope
+    static const VulkanObjectScope* GetCurrent();
+
+    const char* GetName() const { return m_Name; }
+    const std::source_location& GetLocation() const { return m_Location; }
+
+private:
+    const char* m_Name;
+    std::source_location m_Location;
+    const VulkanObjectScope* m_Parent;
+};
+
+// Counts the wrappers of every Vulkan object type and keeps an inventory of the live ones, so churn and leaks
+// show up as numbers instead of lines of created and destructed logs. Counters are atomics, the inventory takes a lock,
+// which is fine at the rate Vulkan objects get created. Counts follow the wrappers: the handle itself may still sit
+// in the deletion queue for a few frames after its wrapper is gone
+class VulkanObjectRegistry
+{
+public:
+    static VulkanObjectRegistry& Get();
+
+    VulkanObjectRegistry(const VulkanObjectRegistry&) = delete;
+    VulkanObjectRegistry& operator=(const VulkanObjectRegistry&) = delete;
+
+    // Returns the id the object is listed under until OnDestroyed
+    uint64_t OnCreated(VulkanObjectType type);
+    void OnDestroyed(VulkanObjectType type, uint64_t id);
+
+    VulkanObjectCounters GetCounters(VulkanObjectType type) const;
+    uint64_t GetLiveCount() const;
+
+    // Live, created and peak counts of every type that was ever created
+    void LogCounters() const;
+
+    // Every live object with the scope it was created in, oldest first
+    void LogLiveObjects() const;
+
+private:
+    VulkanObjectRegistry();
+
+private:
+    struct TypeCounters
+    {
+        std::atomic<uint64_t> Live { 0 };
+        std::atomic<uint64_t> Created { 0 };
+        std::atomic<uint64_t> Peak { 0 };
+    };
+
+    struct LiveObject
+    {
+        VulkanObjectType Type;
+
+        // Copied out of the scope, scopes don't outlive the objects they create
+        const char* ScopeName;
+        const char* File;
+        uint32_t Line;
+
+        std::chrono::steady_clock::time_point CreationTime;
+    };
+
+    std::chrono::steady_clock::time_point m_Epoch;
+    std::array<TypeCounters, static_cast<size_t>(VulkanObjectType::Count)> m_Counters;
+
+    // Ids only grow, so the map iterates in creation order
+    std::atomic<uint64_t> m_NextId;
+    mutable std::mutex m_Mutex;
+    std::map<uint64_t, LiveObject> m_LiveObjects;
+};
+
+// Member that registers its owner for as long as the owner lives. A copied owner is a new object and registers again
+template<VulkanObjectType Type>
+class VulkanObjectTracker
+{
+public:
+    VulkanObjectTracker()
+        : m_Id(VulkanObjectRegistry::Get().OnCreated(Type)) {}
+
+    VulkanObjectTracker(const VulkanObjectTracker&)
+        : VulkanObjectTracker() {}
+
+    VulkanObjectTracker& operator=(const VulkanObjectTracker&) { return *this; }
+
+    ~VulkanObjectTracker()
+    {
+        VulkanObjectRegistry::Get().OnDestroyed(Type, m_Id);
+    }
+
+private:
+    uint64_t m_Id;
+};
+
+#define VULKAN_OBJECT_SCOPE_CONCAT_INNER(a, b) a##b
+#define VULKAN_OBJECT_SCOPE_CONCAT(a, b) VULKAN_OBJECT_SCOPE_CONCAT_INNER(a, b)
+
+// Attributes the Vulkan objects created in the rest of the enclosing scope to |name|
+#define VULKAN_OBJECT_SCOPE(name) VulkanObjectScope VULKAN_OBJECT_SCOPE_CONCAT(vulkanObjectScope, __LINE__)(name)
@@ -0,0 +1,104 @@
+#include "VulkanOffscreenTarget.hpp"
+#include "VulkanCommandBuffer.hpp"
+
+// Readback is only needed for the 8 bit color formats the swapchain would use as well
+static VkDeviceSize GetReadbackPixelSize(VkFormat format)
+{
+    switch(format)
+    {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+VulkanOffscreenTarget::VulkanOffscreenTarget
+(
+    std::shared_ptr<VulkanDevice> device,
+    std::shared_ptr<VulkanRenderPass> renderPass,
+    VkFormat format,
+    VkExtent2D extent,
+    bool readback
+)
+{
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+    if(readback)
+    {
+        if(GetReadbackPixelSize(format) == 0)
+        {
+            Log.Error("Offscreen readback doesn't support format ", format);
+            throw std::runtime_error("Vulkan error");
+        }
+
+        usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+
+    m_Image = VulkanImage2D::Create(device, format, extent, usage);
+    m_ImageView = VulkanImageView::Create(m_Image);
+    m_Framebuffer = std::make_unique<VulkanFramebuffer>(renderPass, m_ImageView);
+
+    // Cached memory keeps the CPU reads fast, coherency is handled by invalidating before reading
+    if(readback)
+    {
+        m_ReadbackBuffer = VulkanBuffer::Create(
+            device,
+            static_cast<VkDeviceSize>(extent.width) * extent.height * GetReadbackPixelSize(format),
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+            VK_MEMORY_PROPERTY_HOST_CACHED_BIT
+        );
+    }
+
+    LOG_DEBUG(VulkanLifetime, "OffscreenTarget created [", extent.width, ", ", extent.height, "]");
+}
+
+VulkanOffscreenTarget::~VulkanOffscreenTarget()
+{
+}
+
+void VulkanOffscreenTarget::RecordReadback(VulkanCommandBuffer& commandBuffer) const
+{
+    if(!m_ReadbackBuffer)
+        return;
+
+    // The render pass already moved the image to the transfer layout, this only orders the writes
+    commandBuffer.ImageBarrier(
+        *m_Image,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_TRANSFER_READ_BIT
+    );
+
+    commandBuffer.CopyImageToBuffer(*m_Image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, *m_ReadbackBuffer);
+
+    commandBuffer.BufferBarrier(
+        *m_ReadbackBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        VK_ACCESS_HOST_READ_BIT
+    );
+}
+
+const void* VulkanOffscreenTarget::ReadPixels() const
+{
+    if(!m_ReadbackBuffer)
+        return nullptr;
+
+    m_ReadbackBuffer->GetDevice()->GetAllocator().Invalidate(m_ReadbackBuffer->GetAllocation());
+
+    return m_ReadbackBuffer->GetMappedData();
+}
+
+VkDeviceSize VulkanOffscreenTarget::GetReadbackSize() const
+{
+    return m_ReadbackBuffer ? m_ReadbackBuffer->GetSize() : 0;
+}
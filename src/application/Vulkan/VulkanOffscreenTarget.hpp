@@ -0,0 +1,53 @@
+#pragma once
+
+#include "VulkanImage2D.hpp"
+#include "VulkanImageView.hpp"
+#include "VulkanFramebuffer.hpp"
+#include "VulkanBuffer.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+class VulkanCommandBuffer;
+
+// A device owned color image with a framebuffer for |renderPass|, standing in for a swapchain image when
+// rendering without a window. |renderPass| has to leave the attachment in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+// when a readback buffer is requested
+class VulkanOffscreenTarget
+{
+public:
+    VulkanOffscreenTarget(
+        std::shared_ptr<VulkanDevice> device,
+        std::shared_ptr<VulkanRenderPass> renderPass,
+        VkFormat format,
+        VkExtent2D extent,
+        bool readback
+    );
+
+    ~VulkanOffscreenTarget();
+
+    VulkanOffscreenTarget(const VulkanOffscreenTarget&) = delete;
+    VulkanOffscreenTarget& operator=(const VulkanOffscreenTarget&) = delete;
+
+    // Copies the rendered image into the readback buffer, recorded after the render pass has ended
+    void RecordReadback(VulkanCommandBuffer& commandBuffer) const;
+
+    // Tightly packed pixels of the last readback, only valid once its submission has completed
+    const void* ReadPixels() const;
+
+    bool HasReadback() const { return m_ReadbackBuffer != nullptr; }
+    VkDeviceSize GetReadbackSize() const;
+
+    const VulkanFramebuffer& GetFramebuffer() const { return *m_Framebuffer; }
+    std::shared_ptr<VulkanImage2D> GetImage() const { return m_Image; }
+    VkExtent2D GetExtent() const { return m_Image->GetExtent(); }
+    VkFormat GetFormat() const { return m_Image->GetFormat(); }
+
+private:
+    std::shared_ptr<VulkanImage2D> m_Image;
+    std::shared_ptr<VulkanImageView> m_ImageView;
+    std::unique_ptr<VulkanFramebuffer> m_Framebuffer;
+
+    // nullptr without readback
+    std::shared_ptr<VulkanBuffer> m_ReadbackBuffer;
+
+    VulkanObjectTracker<VulkanObjectType::OffscreenTarget> m_Tracker;
+};
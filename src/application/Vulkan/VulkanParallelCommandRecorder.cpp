@@ -0,0 +1,174 @@
+#include "VulkanParallelCommandRecorder.hpp"
+#include "../debug/Profiler.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+
+VulkanParallelCommandRecorder::VulkanParallelCommandRecorder
+(
+    std::shared_ptr<VulkanDevice> device,
+    uint32_t queueFamilyIndex,
+    uint32_t frameCount,
+    uint32_t workerCount,
+    uint32_t minDrawsPerRange
+)
+    : m_Device(device), m_FrameIndex(0), m_MinDrawsPerRange(std::max(minDrawsPerRange, 1u)), m_Workers(workerCount)
+{
+    m_Frames.resize(frameCount);
+
+    for(std::vector<ThreadPools>& framePools : m_Frames)
+    {
+        framePools.resize(GetRecordingThreadCount());
+
+        // Buffers are never reset individually, only the whole pool once the frame has retired
+        for(ThreadPools& pools : framePools)
+            pools.CommandPool = std::make_shared<VulkanCommandPool>(device, queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+    }
+
+    LOG_DEBUG(VulkanLifetime, "ParallelCommandRecorder created with ", GetRecordingThreadCount(), " recording threads");
+}
+
+VulkanParallelCommandRecorder::~VulkanParallelCommandRecorder()
+{
+    // The buffers are freed along with their pools
+}
+
+void VulkanParallelCommandRecorder::BeginFrame(uint32_t frameIndex)
+{
+    m_FrameIndex = frameIndex;
+
+    for(ThreadPools& pools : m_Frames[m_FrameIndex])
+    {
+        if(pools.UsedBuffers == 0)
+            continue;
+
+        pools.CommandPool->Reset();
+        pools.UsedBuffers = 0;
+    }
+}
+
+void VulkanParallelCommandRecorder::RecordRenderPass
+(
+    VulkanCommandBuffer& primary,
+    const VulkanRenderPass& renderPass,
+    const VulkanFramebuffer& framebuffer,
+    VulkanRect2D renderArea,
+    const VkClearValue& clearValue,
+    uint32_t drawCount,
+    const VulkanDrawRangeRecorder& record
+)
+{
+    m_Stats.RenderPasses++;
+
+    uint32_t rangeCount = std::min(GetRecordingThreadCount(), drawCount / m_MinDrawsPerRange);
+
+    // Not worth the handoff, secondary buffers have a cost of their own on the GPU too
+    if(rangeCount < 2)
+    {
+        primary.BeginRenderPass(renderPass, framebuffer, renderArea, clearValue, VK_SUBPASS_CONTENTS_INLINE);
+
+        if(drawCount > 0)
+            record(primary, 0, drawCount);
+
+        primary.EndRenderPass();
+        return;
+    }
+
+    m_Stats.ParallelRenderPasses++;
+
+    std::vector<ThreadPools>& framePools = m_Frames[m_FrameIndex];
+
+    // Allocated up front on this thread, allocation touches the pool and logs
+    std::vector<VulkanCommandBuffer*> secondaryBuffers(rangeCount);
+    for(uint32_t i = 0; i < rangeCount; i++)
+        secondaryBuffers[i] = &AcquireBuffer(framePools[i]);
+
+    auto recordRange = [&renderPass, &framebuffer, &record](VulkanCommandBuffer& commandBuffer, uint32_t firstDraw, uint32_t rangeDrawCount)
+    {
+        PROFILE_ZONE("RecordDrawRange");
+
+        if(!commandBuffer.BeginSecondary(renderPass, 0, &framebuffer))
+            throw std::runtime_error("Vulkan error");
+
+        record(commandBuffer, firstDraw, rangeDrawCount);
+
+        commandBuffer.End();
+    };
+
+    // The first ranges take one extra draw each when the count doesn't divide evenly
+    uint32_t drawsPerRange = drawCount / rangeCount;
+    uint32_t remainder = drawCount % rangeCount;
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(rangeCount - 1);
+
+    uint32_t firstDraw = 0;
+    for(uint32_t i = 0; i < rangeCount; i++)
+    {
+        uint32_t rangeDrawCount = drawsPerRange + (i < remainder ? 1 : 0);
+        VulkanCommandBuffer* commandBuffer = secondaryBuffers[i];
+
+        // The last range is recorded here instead of idling until the workers are done
+        if(i + 1 < rangeCount)
+            pending.push_back(m_Workers.Submit([&recordRange, commandBuffer, firstDraw, rangeDrawCount]() { recordRange(*commandBuffer, firstDraw, rangeDrawCount); }));
+        else
+        {
+            std::exception_ptr error;
+
+            try
+            {
+                recordRange(*commandBuffer, firstDraw, rangeDrawCount);
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+
+            // Every job has to finish before the captured references go out of scope, even after a failure
+            for(std::future<void>& job : pending)
+            {
+                try
+                {
+                    job.get();
+                }
+                catch(...)
+                {
+                    if(!error)
+                        error = std::current_exception();
+                }
+            }
+
+            if(error)
+            {
+                Log.Error("Parallel command recording failed");
+                std::rethrow_exception(error);
+            }
+        }
+
+        firstDraw += rangeDrawCount;
+    }
+
+    m_Stats.SecondaryBuffersRecorded += rangeCount;
+
+    primary.BeginRenderPass(renderPass, framebuffer, renderArea, clearValue, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    primary.ExecuteCommands(std::vector<const VulkanCommandBuffer*>(secondaryBuffers.begin(), secondaryBuffers.end()));
+    primary.EndRenderPass();
+}
+
+void VulkanParallelCommandRecorder::LogStats() const
+{
+    Log.Info("ParallelCommandRecorder ", m_Stats.RenderPasses, " render passes, ", m_Stats.ParallelRenderPasses, " split, ",
+        m_Stats.SecondaryBuffersRecorded, " secondary buffers recorded, ", m_Stats.SecondaryBuffersAllocated, " allocated");
+}
+
+VulkanCommandBuffer& VulkanParallelCommandRecorder::AcquireBuffer(ThreadPools& pools)
+{
+    if(pools.UsedBuffers == pools.Buffers.size())
+    {
+        pools.Buffers.emplace_back(pools.CommandPool->CreateSecondaryBuffer());
+        m_Stats.SecondaryBuffersAllocated++;
+    }
+
+    return *pools.Buffers[pools.UsedBuffers++];
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "VulkanCommandBuffer.hpp"
+#include "VulkanObjectRegistry.hpp"
+#include "../ThreadPool.hpp"
+
+#include <functional>
+
+// Records draws [firstDraw, firstDraw + drawCount) into |commandBuffer|, which is already inside the render pass.
+// Runs on a worker thread when the pass is split, so it must not touch the Log or other shared state.
+// Secondary buffers don't inherit dynamic state, pipeline and viewport have to be bound again in every range
+using VulkanDrawRangeRecorder = std::function<void(VulkanCommandBuffer& commandBuffer, uint32_t firstDraw, uint32_t drawCount)>;
+
+struct VulkanParallelRecorderStats
+{
+    uint32_t RenderPasses = 0;
+
+    // Render passes that were split across threads, the rest were recorded inline
+    uint32_t ParallelRenderPasses = 0;
+
+    uint32_t SecondaryBuffersRecorded = 0;
+    uint32_t SecondaryBuffersAllocated = 0;
+};
+
+// Splits the draws of a render pass into ranges recorded into secondary command buffers on a worker pool.
+// Every recording thread, the calling one included, has its own command pool per frame in flight, so pools
+// are never shared between threads and a frame's pools are reset as a whole instead of buffer by buffer
+class VulkanParallelCommandRecorder
+{
+public:
+    VulkanParallelCommandRecorder(
+        std::shared_ptr<VulkanDevice> device,
+        uint32_t queueFamilyIndex,
+        uint32_t frameCount,
+        uint32_t workerCount = ThreadPool::DefaultWorkerCount(),
+        uint32_t minDrawsPerRange = 64
+    );
+
+    ~VulkanParallelCommandRecorder();
+
+    VulkanParallelCommandRecorder(const VulkanParallelCommandRecorder&) = delete;
+    VulkanParallelCommandRecorder& operator=(const VulkanParallelCommandRecorder&) = delete;
+
+    // Resets the pools of |frameIndex|. Must only be called once the fence of the frame that last used it has signaled
+    void BeginFrame(uint32_t frameIndex);
+
+    // Begins |renderPass| on |primary|, records |drawCount| draws through |record| and ends the pass.
+    // Passes with fewer than two ranges worth of draws are recorded inline on the calling thread
+    void RecordRenderPass(
+        VulkanCommandBuffer& primary,
+        const VulkanRenderPass& renderPass,
+        const VulkanFramebuffer& framebuffer,
+        VulkanRect2D renderArea,
+        const VkClearValue& clearValue,
+        uint32_t drawCount,
+        const VulkanDrawRangeRecorder& record
+    );
+
+    // Threads recording at once, the calling thread included
+    uint32_t GetRecordingThreadCount() const { return m_Workers.GetWorkerCount() + 1; }
+
+    const VulkanParallelRecorderStats& GetStats() const { return m_Stats; }
+    void LogStats() const;
+
+private:
+    struct ThreadPools
+    {
+        std::shared_ptr<VulkanCommandPool> CommandPool;
+        std::vector<std::unique_ptr<VulkanCommandBuffer>> Buffers;
+
+        // Buffers handed out since the last reset, reused in order next time
+        uint32_t UsedBuffers = 0;
+    };
+
+    VulkanCommandBuffer& AcquireBuffer(ThreadPools& pools);
+
+private:
+    std::shared_ptr<VulkanDevice> m_Device;
+
+    // Indexed by frame, then by recording thread
+    std::vector<std::vector<ThreadPools>> m_Frames;
+    uint32_t m_FrameIndex;
+
+    uint32_t m_MinDrawsPerRange;
+
+    VulkanParallelRecorderStats m_Stats;
+
+    VulkanObjectTracker<VulkanObjectType::CommandRecorder> m_Tracker;
+
+    // Declared last so the workers are joined before the pools they record into are destroyed
+    ThreadPool m_Workers;
+};
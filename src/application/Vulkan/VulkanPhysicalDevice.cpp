@@ -1,11 +1,13 @@
 #include "VulkanPhysicalDevice.hpp"
 #include "VulkanInstance.hpp"
 
+#include <algorithm>
+
 VulkanPhysicalDevice::VulkanPhysicalDevice(std::shared_ptr<VulkanInstance> vulkanInstance, VkPhysicalDevice deviceHandle, uint32_t deviceId)
-    : m_Instance(vulkanInstance), m_PhysicalDevice(deviceHandle), m_PhysicalDeviceIndex(deviceId)
+    : m_Instance(vulkanInstance), m_PhysicalDevice(deviceHandle), m_SupportsTimelineSemaphores(false), m_SupportsSynchronization2(false), m_PhysicalDeviceIndex(deviceId)
 {
     QueryDeviceProperties();
-    QueryDeviceFeatures();
+    QueryDeviceMemoryProperties();
     QueryDeviceExtensionProperties();
     
     // m_Extension contains only the names of available extensions
@@ -14,14 +16,14 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(std::shared_ptr<VulkanInstance> vulka
         m_Extensions.push_back(extension.extensionName);
     }
 
+    // Optional features depend on the extension list
+    QueryDeviceFeatures();
+
     QueryDeviceQueueFamilyInfos();
-    
-    Log.Info("Created VulkanPhysicalDevice");
 }
 
 VulkanPhysicalDevice::~VulkanPhysicalDevice()
 {
-    Log.Info("Destructed VulkanPhysicalDevice");
 }
 
 std::vector<VkQueueFamilyProperties> VulkanPhysicalDevice::EnumerateDeviceQueueFamilyProperties()
@@ -44,6 +46,47 @@ void VulkanPhysicalDevice::QueryDeviceProperties()
 void VulkanPhysicalDevice::QueryDeviceFeatures()
 {
     vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &m_Features);
+
+    // Features2 itself is core since 1.1, which is the lowest version the instance is created with
+    if(m_Properties.apiVersion < VK_API_VERSION_1_1)
+        return;
+
+    bool timelineAvailable = m_Properties.apiVersion >= VK_API_VERSION_1_2 && m_Instance->GetApiVersion() >= VK_API_VERSION_1_2;
+    bool synchronization2Available = std::find(m_Extensions.begin(), m_Extensions.end(), VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME) != m_Extensions.end();
+
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures {};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
+    VkPhysicalDeviceSynchronization2Features synchronization2Features {};
+    synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+
+    // Structs of unsupported versions or extensions may not be chained
+    void** next = &features.pNext;
+
+    if(timelineAvailable)
+    {
+        *next = &timelineFeatures;
+        next = &timelineFeatures.pNext;
+    }
+
+    if(synchronization2Available)
+    {
+        *next = &synchronization2Features;
+        next = &synchronization2Features.pNext;
+    }
+
+    vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &features);
+
+    m_SupportsTimelineSemaphores = timelineFeatures.timelineSemaphore == VK_TRUE;
+    m_SupportsSynchronization2 = synchronization2Features.synchronization2 == VK_TRUE;
+}
+
+void VulkanPhysicalDevice::QueryDeviceMemoryProperties()
+{
+    vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &m_MemoryProperties);
 }
 
 void VulkanPhysicalDevice::QueryDeviceExtensionProperties()
@@ -87,7 +130,52 @@ void VulkanPhysicalDevice::QueryDeviceQueueFamilyInfos()
     }
 }
 
-SwapchainSupportDetails VulkanPhysicalDevice::GetSwapchainSupportDetails(VkSurfaceKHR surface)
+const SwapchainSupportDetails& VulkanPhysicalDevice::GetSwapchainSupportDetails(VkSurfaceKHR surface)
+{
+    auto it = m_SurfaceCache.find(surface);
+
+    if(it == m_SurfaceCache.end())
+    {
+        m_SurfaceCacheStats.Misses++;
+
+        it = m_SurfaceCache.emplace(surface, SurfaceCacheEntry{ QuerySwapchainSupportDetails(surface), true }).first;
+    }
+    else if(!it->second.CapabilitiesValid)
+    {
+        m_SurfaceCacheStats.CapabilityRefreshes++;
+
+        VkResult result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_PhysicalDevice, surface, &it->second.Details.Capabilities);
+
+        if(result != VK_SUCCESS)
+        {
+            Log.Error("vkGetPhysicalDeviceSurfaceCapabilitiesKHR failed");
+            throw std::runtime_error("Failed to query surface capabilities");
+        }
+
+        it->second.CapabilitiesValid = true;
+    }
+    else
+    {
+        m_SurfaceCacheStats.Hits++;
+    }
+
+    return it->second.Details;
+}
+
+void VulkanPhysicalDevice::InvalidateSurfaceCapabilities(VkSurfaceKHR surface)
+{
+    auto it = m_SurfaceCache.find(surface);
+
+    if(it != m_SurfaceCache.end())
+        it->second.CapabilitiesValid = false;
+}
+
+void VulkanPhysicalDevice::InvalidateSurface(VkSurfaceKHR surface)
+{
+    m_SurfaceCache.erase(surface);
+}
+
+SwapchainSupportDetails VulkanPhysicalDevice::QuerySwapchainSupportDetails(VkSurfaceKHR surface)
 {
     SwapchainSupportDetails swapchainSupportDetails;
     vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_PhysicalDevice, surface, &swapchainSupportDetails.Capabilities);
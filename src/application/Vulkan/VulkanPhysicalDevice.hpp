@@ -1,10 +1,12 @@
 #pragma once
 
 #include "../debug/Log.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 #include <vulkan/vulkan.hpp>
 #include <SDL3/SDL_vulkan.h>
 
+#include <map>
 #include <vector>
 
 struct SwapchainSupportDetails
@@ -14,6 +16,18 @@ struct SwapchainSupportDetails
     std::vector<VkPresentModeKHR> PresentModes;
 };
 
+struct VulkanSurfaceCacheStats
+{
+    // Answered without calling the driver
+    uint32_t Hits = 0;
+
+    // Surface seen for the first time or invalidated, everything was queried
+    uint32_t Misses = 0;
+
+    // Only the capabilities were queried again
+    uint32_t CapabilityRefreshes = 0;
+};
+
 struct VulkanQueueFamilyInfo
 {
     VkQueueFamilyProperties Properties;
@@ -42,12 +56,29 @@ public:
     
     const VkPhysicalDeviceProperties& GetProperties() { return m_Properties;}
     const VkPhysicalDeviceFeatures& GetFeatures() { return m_Features; }
+
+    // Needs both the device and the instance at 1.2
+    bool SupportsTimelineSemaphores() const { return m_SupportsTimelineSemaphores; }
+
+    // Through VK_KHR_synchronization2, the instance doesn't go up to 1.3 where it is core
+    bool SupportsSynchronization2() const { return m_SupportsSynchronization2; }
+    const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() { return m_MemoryProperties; }
     const std::vector<VkExtensionProperties>& GetExtensionProperties() { return m_ExtensionProperties; }
     const std::vector<std::string>& GetExtensions() { return m_Extensions; }
     const std::vector<std::string>& GetEnabledExtensions() { return m_EnabledExtensions; }
     const std::vector<VulkanQueueFamilyInfo>& GetQueueFamilyInfos() { return m_QueueFamilies; }
     
-    SwapchainSupportDetails GetSwapchainSupportDetails(VkSurfaceKHR surface);
+    // Cached per surface. Formats and present modes are queried once, capabilities again after InvalidateSurfaceCapabilities.
+    // The reference stays valid until InvalidateSurface is called for |surface|
+    const SwapchainSupportDetails& GetSwapchainSupportDetails(VkSurfaceKHR surface);
+
+    // Call when the surface was resized or reported out of date, its current extent and transform may have changed
+    void InvalidateSurfaceCapabilities(VkSurfaceKHR surface);
+
+    // Drops everything cached for |surface|, e.g. before destroying it since the handle may be reused
+    void InvalidateSurface(VkSurfaceKHR surface);
+
+    const VulkanSurfaceCacheStats& GetSurfaceCacheStats() const { return m_SurfaceCacheStats; }
     
     ~VulkanPhysicalDevice();
 
@@ -98,8 +129,10 @@ public:
 private:
     void QueryDeviceProperties();
     void QueryDeviceFeatures();
+    void QueryDeviceMemoryProperties();
     void QueryDeviceExtensionProperties();
     void QueryDeviceQueueFamilyInfos();
+    SwapchainSupportDetails QuerySwapchainSupportDetails(VkSurfaceKHR surface);
 
     friend class VulkanDeviceSelector;
     void EnableExtension(const std::string& extensions);
@@ -110,6 +143,9 @@ private:
 
     VkPhysicalDeviceProperties m_Properties;
     VkPhysicalDeviceFeatures m_Features;
+    VkPhysicalDeviceMemoryProperties m_MemoryProperties;
+    bool m_SupportsTimelineSemaphores;
+    bool m_SupportsSynchronization2;
 
     std::vector<VkExtensionProperties> m_ExtensionProperties;
 
@@ -123,6 +159,17 @@ private:
     std::vector<VulkanQueueFamilyInfo> m_QueueFamilies;
     
     uint32_t m_PhysicalDeviceIndex;
+
+    struct SurfaceCacheEntry
+    {
+        SwapchainSupportDetails Details;
+        bool CapabilitiesValid;
+    };
+
+    std::map<VkSurfaceKHR, SurfaceCacheEntry> m_SurfaceCache;
+    VulkanSurfaceCacheStats m_SurfaceCacheStats;
+
+    VulkanObjectTracker<VulkanObjectType::PhysicalDevice> m_Tracker;
 };
 
 std::string PresentModeToString(VkPresentModeKHR presentMode);
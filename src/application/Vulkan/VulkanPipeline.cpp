@@ -14,7 +14,10 @@ VulkanPipeline::VulkanPipeline
 
 VulkanPipeline::~VulkanPipeline()
 {
-    vkDestroyPipeline(m_Device->GetHandle(), m_Pipeline, nullptr);
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), pipeline = m_Pipeline]()
+    {
+        vkDestroyPipeline(device, pipeline, nullptr);
+    });
 }
 
 VkPipeline VulkanPipeline::GetHandle() const 
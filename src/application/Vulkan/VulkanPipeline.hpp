@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 class VulkanPipelineLayout;
 
@@ -25,4 +26,6 @@ protected:
 
     VkPipelineBindPoint m_BindPoint;
     std::shared_ptr<VulkanPipelineLayout> m_Layout;
+
+    VulkanObjectTracker<VulkanObjectType::Pipeline> m_Tracker;
 };
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "VulkanPipelineCache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+static uint64_t HashBlob(const std::vector<char>& blob)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+
+    for(char byte : blob)
+    {
+        hash ^= static_cast<uint8_t>(byte);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+// Writes |blob| and makes sure it reached the disk, a rename alone may land before the data does
+static bool WriteDurably(const std::string& path, const std::vector<char>& blob)
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+
+    if(!file)
+        return false;
+
+    bool written = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size() && std::fflush(file) == 0;
+
+#ifdef _WIN32
+    written = written && _commit(_fileno(file)) == 0;
+#else
+    written = written && fsync(fileno(file)) == 0;
+#endif
+
+    return std::fclose(file) == 0 && written;
+}
+
+VulkanPipelineCache::VulkanPipelineCache
+(
+    VkDevice device,
+    std::shared_ptr<VulkanPhysicalDevice> physicalDevice,
+    const std::string& path,
+    std::chrono::seconds saveInterval
+) : m_Device(device),
+    m_PhysicalDevice(physicalDevice),
+    m_PipelineCache(VK_NULL_HANDLE),
+    m_Path(path),
+    m_SaveInterval(saveInterval),
+    m_LastSave(std::chrono::steady_clock::now()),
+    m_SavedSize(0),
+    m_SavedHash(0),
+    m_Saver(1)
+{
+    std::vector<char> blob = LoadValidatedBlob();
+
+    VkPipelineCacheCreateInfo createInfo {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = blob.size();
+    createInfo.pInitialData = blob.empty() ? nullptr : blob.data();
+
+    VkResult result = vkCreatePipelineCache(m_Device, &createInfo, nullptr, &m_PipelineCache);
+
+    // Drivers may still reject a blob that passed the header check, start from scratch then
+    if(result != VK_SUCCESS && !blob.empty())
+    {
+        Log.Warn("Driver rejected pipeline cache ", m_Path, ", starting with an empty cache");
+
+        blob.clear();
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+
+        result = vkCreatePipelineCache(m_Device, &createInfo, nullptr, &m_PipelineCache);
+    }
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error("vkCreatePipelineCache failed");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    m_SavedSize = blob.size();
+    m_SavedHash = HashBlob(blob);
+
+    LOG_DEBUG(VulkanLifetime, "PipelineCache created (", blob.size(), " bytes loaded)");
+}
+
+VulkanPipelineCache::~VulkanPipelineCache()
+{
+    if(m_PendingSave.valid())
+        m_PendingSave.wait();
+
+    Save();
+
+    vkDestroyPipelineCache(m_Device, m_PipelineCache, nullptr);
+}
+
+bool VulkanPipelineCache::Save()
+{
+    if(m_Path.empty())
+        return false;
+
+    std::lock_guard lock(m_SaveMutex);
+
+    size_t size = 0;
+    VkResult result = vkGetPipelineCacheData(m_Device, m_PipelineCache, &size, nullptr);
+
+    if(result != VK_SUCCESS || size == 0)
+        return false;
+
+    std::vector<char> blob(size);
+    result = vkGetPipelineCacheData(m_Device, m_PipelineCache, &size, blob.data());
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Warn("vkGetPipelineCacheData failed");
+        return false;
+    }
+
+    blob.resize(size);
+
+    uint64_t hash = HashBlob(blob);
+
+    if(size == m_SavedSize && hash == m_SavedHash)
+        return false;
+
+    const std::string temporaryPath = m_Path + ".tmp";
+
+    std::error_code error;
+
+    if(!WriteDurably(temporaryPath, blob))
+    {
+        Log.Warn("Failed to write ", temporaryPath);
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(temporaryPath, m_Path, error);
+
+    if(error)
+    {
+        Log.Warn("Failed to replace ", m_Path, ": ", error.message());
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    m_SavedSize = size;
+    m_SavedHash = hash;
+
+    Log.Info("PipelineCache saved (", size, " bytes)");
+
+    return true;
+}
+
+bool VulkanPipelineCache::SaveIfDue()
+{
+    if(m_Path.empty() || std::chrono::steady_clock::now() - m_LastSave < m_SaveInterval)
+        return false;
+
+    // A slow disk shouldn't pile up saves
+    if(m_PendingSave.valid() && m_PendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+
+    m_LastSave = std::chrono::steady_clock::now();
+
+    // Reading the cache back, hashing and writing it takes long enough to show up as a hitch on the render thread
+    m_PendingSave = m_Saver.Submit([this]() { return Save(); });
+
+    return true;
+}
+
+std::vector<char> VulkanPipelineCache::LoadValidatedBlob() const
+{
+    if(m_Path.empty())
+        return {};
+
+    std::ifstream file(m_Path, std::ios::ate | std::ios::binary);
+
+    if(!file.is_open())
+        return {};
+
+    std::vector<char> blob(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(blob.data(), blob.size());
+
+    if(!file.good() || !IsBlobCompatible(blob))
+    {
+        Log.Warn("Ignoring incompatible pipeline cache ", m_Path);
+        return {};
+    }
+
+    return blob;
+}
+
+bool VulkanPipelineCache::IsBlobCompatible(const std::vector<char>& blob) const
+{
+    VkPipelineCacheHeaderVersionOne header;
+
+    if(blob.size() < sizeof(header))
+        return false;
+
+    std::memcpy(&header, blob.data(), sizeof(header));
+
+    const VkPhysicalDeviceProperties& properties = m_PhysicalDevice->GetProperties();
+
+    return header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+        && header.headerSize >= sizeof(header)
+        && header.headerSize <= blob.size()
+        && header.vendorID == properties.vendorID
+        && header.deviceID == properties.deviceID
+        && std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
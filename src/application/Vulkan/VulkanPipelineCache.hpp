@@ -0,0 +1,64 @@
+#pragma once
+
+#include "VulkanPhysicalDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
+#include "../ThreadPool.hpp"
+
+#include <Vulkan/vulkan.hpp>
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+
+class VulkanPipelineCache
+{
+public:
+    // An empty |path| keeps the cache in memory only
+    VulkanPipelineCache(
+        VkDevice device,
+        std::shared_ptr<VulkanPhysicalDevice> physicalDevice,
+        const std::string& path,
+        std::chrono::seconds saveInterval = std::chrono::seconds(60)
+    );
+
+    ~VulkanPipelineCache();
+
+    VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+    VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+    // Writes to a temporary file, flushes it to disk and renames it over the old one so a crash never leaves
+    // a torn cache. Blocks for the whole write. Returns false if nothing was written
+    bool Save();
+
+    // Cheap enough to call every frame. Once |saveInterval| has passed it hands a Save to a background thread,
+    // returns true if one was started
+    bool SaveIfDue();
+
+    VkPipelineCache GetHandle() const { return m_PipelineCache; }
+
+private:
+    std::vector<char> LoadValidatedBlob() const;
+    bool IsBlobCompatible(const std::vector<char>& blob) const;
+
+private:
+    VkDevice m_Device;
+    std::shared_ptr<VulkanPhysicalDevice> m_PhysicalDevice;
+    VkPipelineCache m_PipelineCache;
+
+    std::string m_Path;
+    std::chrono::seconds m_SaveInterval;
+
+    // Only touched by the thread calling SaveIfDue
+    std::chrono::steady_clock::time_point m_LastSave;
+    std::future<bool> m_PendingSave;
+
+    // Serializes saves and guards the size and hash of the last blob on disk, used to skip writing identical data
+    std::mutex m_SaveMutex;
+    size_t m_SavedSize;
+    uint64_t m_SavedHash;
+
+    ThreadPool m_Saver;
+
+    VulkanObjectTracker<VulkanObjectType::PipelineCache> m_Tracker;
+};
@@ -14,9 +14,33 @@ VulkanPipelineColorBlendState::VulkanPipelineColorBlendState
         logicOpEnable ? VK_TRUE : VK_FALSE,
         logicOp,
         static_cast<uint32_t>(attachments.size()),
-        attachments.data(),
+        VK_NULL_HANDLE,
         { blendConstants[0], blendConstants[1], blendConstants[2], blendConstants[3] }
-    }
+    },
+    m_Attachments(attachments.begin(), attachments.end())
+{
+    pAttachments = m_Attachments.data();
+}
+
+VulkanPipelineColorBlendState::VulkanPipelineColorBlendState
+(
+    const VulkanPipelineColorBlendState& other
+) : VkPipelineColorBlendStateCreateInfo(other),
+    m_Attachments(other.m_Attachments)
 {
+    pAttachments = m_Attachments.data();
+}
+
+VulkanPipelineColorBlendState& VulkanPipelineColorBlendState::operator=(const VulkanPipelineColorBlendState& other)
+{
+    if(this == &other)
+        return *this;
+
+    VkPipelineColorBlendStateCreateInfo::operator=(other);
+
+    m_Attachments = other.m_Attachments;
+
+    pAttachments = m_Attachments.data();
 
-}
\ No newline at end of file
+    return *this;
+}
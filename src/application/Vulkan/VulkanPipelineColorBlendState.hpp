@@ -16,5 +16,10 @@ public:
         const std::array<float, 4>& floats = {0, 0, 0, 0}
     );
 
+    VulkanPipelineColorBlendState(const VulkanPipelineColorBlendState& other);
+    VulkanPipelineColorBlendState& operator=(const VulkanPipelineColorBlendState& other);
+
     operator const VkPipelineColorBlendStateCreateInfo*() const { return this; }
-};
\ No newline at end of file
+private:
+    std::vector<VkPipelineColorBlendAttachmentState> m_Attachments;
+};
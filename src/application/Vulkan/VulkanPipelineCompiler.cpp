@@ -0,0 +1,160 @@
+#include "VulkanPipelineCompiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+bool VulkanPipelineCompileHandle::IsReady() const
+{
+    return m_Future.valid() && m_Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+std::shared_ptr<VulkanGraphicsPipeline> VulkanPipelineCompileHandle::Get() const
+{
+    return m_Future.get().Pipeline;
+}
+
+std::shared_ptr<VulkanGraphicsPipeline> VulkanPipelineCompileHandle::TryGet() const
+{
+    if(!IsReady())
+        return nullptr;
+
+    try
+    {
+        return m_Future.get().Pipeline;
+    }
+    catch(const std::exception&)
+    {
+        return nullptr;
+    }
+}
+
+VulkanPipelineCompiler::VulkanPipelineCompiler(VulkanPipelineLibrary& library, uint32_t workerCount)
+    : m_Library(library),
+      m_QueueDepth(0),
+      m_CompiledCount(0),
+      m_FailedCount(0),
+      m_TotalCompileSeconds(0.0f),
+      m_MaxCompileSeconds(0.0f),
+      m_Workers(workerCount)
+{
+    LOG_DEBUG(VulkanLifetime, "PipelineCompiler created with ", m_Workers.GetWorkerCount(), " workers");
+}
+
+VulkanPipelineCompiler::~VulkanPipelineCompiler()
+{
+}
+
+VulkanPipelineCompileHandle VulkanPipelineCompiler::Compile(const VulkanGraphicsPipelineDescription& description)
+{
+    if(std::shared_ptr<VulkanGraphicsPipeline> pipeline = m_Library.FindGraphicsPipeline(description))
+    {
+        std::promise<VulkanPipelineCompileResult> promise;
+        promise.set_value(VulkanPipelineCompileResult{pipeline});
+
+        return VulkanPipelineCompileHandle(promise.get_future().share());
+    }
+
+    std::string key = VulkanPipelineLibrary::BuildKey(description);
+
+    // Held across the submit so the worker can't finish and unlist the compile before it is listed
+    std::lock_guard pendingLock(m_PendingMutex);
+
+    if(!key.empty())
+    {
+        auto pending = m_PendingCompiles.find(key);
+        if(pending != m_PendingCompiles.end())
+            return VulkanPipelineCompileHandle(pending->second);
+    }
+
+    m_QueueDepth++;
+
+    auto submitted = std::chrono::steady_clock::now();
+
+    std::future<VulkanPipelineCompileResult> future = m_Workers.Submit([this, description, submitted, key]()
+    {
+        auto started = std::chrono::steady_clock::now();
+
+        VulkanPipelineCompileResult result;
+        result.QueueSeconds = std::chrono::duration<float>(started - submitted).count();
+
+        bool created = false;
+
+        try
+        {
+            result.Pipeline = m_Library.GetOrCreateGraphicsPipeline(description, &created);
+        }
+        catch(const std::exception&)
+        {
+            FinishCompile(key);
+
+            std::lock_guard lock(m_StatsMutex);
+            m_FailedCount++;
+
+            throw;
+        }
+
+        result.CompileSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - started).count();
+
+        // The pipeline is in the library now, later requests find it there
+        FinishCompile(key);
+
+        if(created)
+        {
+            std::lock_guard lock(m_StatsMutex);
+            m_CompiledCount++;
+            m_TotalCompileSeconds += result.CompileSeconds;
+            m_MaxCompileSeconds = std::max(m_MaxCompileSeconds, result.CompileSeconds);
+        }
+
+        return result;
+    });
+
+    std::shared_future<VulkanPipelineCompileResult> shared = future.share();
+
+    if(!key.empty())
+        m_PendingCompiles.emplace(std::move(key), shared);
+
+    return VulkanPipelineCompileHandle(shared);
+}
+
+void VulkanPipelineCompiler::FinishCompile(const std::string& key)
+{
+    m_QueueDepth--;
+
+    if(key.empty())
+        return;
+
+    std::lock_guard lock(m_PendingMutex);
+    m_PendingCompiles.erase(key);
+}
+
+std::shared_ptr<VulkanGraphicsPipeline> VulkanPipelineCompiler::Resolve(const VulkanPipelineCompileHandle& handle) const
+{
+    std::shared_ptr<VulkanGraphicsPipeline> pipeline = handle.TryGet();
+
+    return pipeline ? pipeline : m_FallbackPipeline;
+}
+
+VulkanPipelineCompilerStats VulkanPipelineCompiler::GetStats() const
+{
+    VulkanPipelineCompilerStats stats;
+    stats.QueueDepth = m_QueueDepth;
+
+    std::lock_guard lock(m_StatsMutex);
+    stats.CompiledCount = m_CompiledCount;
+    stats.FailedCount = m_FailedCount;
+    stats.TotalCompileSeconds = m_TotalCompileSeconds;
+    stats.MaxCompileSeconds = m_MaxCompileSeconds;
+
+    return stats;
+}
+
+void VulkanPipelineCompiler::LogStats() const
+{
+    VulkanPipelineCompilerStats stats = GetStats();
+
+    float averageMs = stats.CompiledCount ? stats.TotalCompileSeconds * 1000.0f / stats.CompiledCount : 0.0f;
+
+    Log.Info("PipelineCompiler ", stats.CompiledCount, " compiled, ", stats.FailedCount, " failed, ", stats.QueueDepth, " queued, ",
+        "average ", averageMs, " ms, max ", stats.MaxCompileSeconds * 1000.0f, " ms");
+}
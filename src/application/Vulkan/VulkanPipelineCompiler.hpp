@@ -0,0 +1,106 @@
+#pragma once
+
+#include "VulkanPipelineLibrary.hpp"
+#include "VulkanObjectRegistry.hpp"
+#include "../ThreadPool.hpp"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct VulkanPipelineCompileResult
+{
+    std::shared_ptr<VulkanGraphicsPipeline> Pipeline;
+
+    // Time spent waiting for a worker and inside vkCreateGraphicsPipelines
+    float QueueSeconds = 0.0f;
+    float CompileSeconds = 0.0f;
+};
+
+// Refers to a pipeline that may still be compiling. Cheap to copy
+class VulkanPipelineCompileHandle
+{
+public:
+    VulkanPipelineCompileHandle() = default;
+    VulkanPipelineCompileHandle(std::shared_future<VulkanPipelineCompileResult> future) : m_Future(std::move(future)) {}
+
+    bool IsValid() const { return m_Future.valid(); }
+    bool IsReady() const;
+
+    // Blocks until compilation finishes, rethrows if it failed
+    std::shared_ptr<VulkanGraphicsPipeline> Get() const;
+
+    // Never blocks, nullptr while compiling or if compilation failed
+    std::shared_ptr<VulkanGraphicsPipeline> TryGet() const;
+
+    // Blocks like Get
+    const VulkanPipelineCompileResult& GetResult() const { return m_Future.get(); }
+
+private:
+    std::shared_future<VulkanPipelineCompileResult> m_Future;
+};
+
+struct VulkanPipelineCompilerStats
+{
+    // Submitted pipelines not finished yet, including the ones being compiled
+    uint32_t QueueDepth = 0;
+
+    // Pipelines a worker actually built. Requests that found their pipeline in the library or joined a pending
+    // compile aren't counted, nor are they in the compile times
+    uint32_t CompiledCount = 0;
+    uint32_t FailedCount = 0;
+
+    float TotalCompileSeconds = 0.0f;
+    float MaxCompileSeconds = 0.0f;
+};
+
+// Builds graphics pipelines on a worker pool so the render thread never waits on the driver.
+// Compiles go through |library|, so a pipeline that was built before is ready immediately,
+// and a request equal to one still compiling gets a handle to that compile
+class VulkanPipelineCompiler
+{
+public:
+    VulkanPipelineCompiler(VulkanPipelineLibrary& library, uint32_t workerCount = ThreadPool::DefaultWorkerCount());
+    ~VulkanPipelineCompiler();
+
+    VulkanPipelineCompiler(const VulkanPipelineCompiler&) = delete;
+    VulkanPipelineCompiler& operator=(const VulkanPipelineCompiler&) = delete;
+
+    VulkanPipelineCompileHandle Compile(const VulkanGraphicsPipelineDescription& description);
+
+    // Pipeline bound while the requested one is still compiling. Without one Resolve returns nullptr
+    // and the caller is expected to skip the draw
+    void SetFallbackPipeline(std::shared_ptr<VulkanGraphicsPipeline> pipeline) { m_FallbackPipeline = pipeline; }
+
+    // The compiled pipeline if it is ready, the fallback pipeline otherwise
+    std::shared_ptr<VulkanGraphicsPipeline> Resolve(const VulkanPipelineCompileHandle& handle) const;
+
+    VulkanPipelineCompilerStats GetStats() const;
+    void LogStats() const;
+
+private:
+    // Called by the worker once a compile is done, whether or not it succeeded
+    void FinishCompile(const std::string& key);
+
+private:
+    VulkanPipelineLibrary& m_Library;
+    std::shared_ptr<VulkanGraphicsPipeline> m_FallbackPipeline;
+
+    // Compiles submitted but not finished, by library key
+    std::unordered_map<std::string, std::shared_future<VulkanPipelineCompileResult>> m_PendingCompiles;
+    std::mutex m_PendingMutex;
+
+    std::atomic<uint32_t> m_QueueDepth;
+    uint32_t m_CompiledCount;
+    uint32_t m_FailedCount;
+    float m_TotalCompileSeconds;
+    float m_MaxCompileSeconds;
+    mutable std::mutex m_StatsMutex;
+
+    VulkanObjectTracker<VulkanObjectType::PipelineCompiler> m_Tracker;
+
+    // Declared last so the workers are joined before the members they use are destroyed
+    ThreadPool m_Workers;
+};
@@ -12,14 +12,14 @@ VulkanPipelineLayout::VulkanPipelineLayout(std::shared_ptr<VulkanDevice> device,
         Log.Error("Failed to create pipeline layout");
         throw std::runtime_error("Vulkan error");
     }
-
-    Log.Info("PipelineLayout created");
 }
 
 VulkanPipelineLayout::~VulkanPipelineLayout()
 {
-    vkDestroyPipelineLayout(m_Device->GetHandle(), m_PipelineLayout, nullptr);
-    Log.Info("PipelineLayout destructed");
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), pipelineLayout = m_PipelineLayout]()
+    {
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    });
 }
 
 std::shared_ptr<VulkanPipelineLayout> VulkanPipelineLayout::Create(std::shared_ptr<VulkanDevice> device, const VkPipelineLayoutCreateInfo& createInfo)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 class VulkanPipelineLayout
 {
@@ -14,4 +15,6 @@ public:
 private:
     std::shared_ptr<VulkanDevice> m_Device;
     VkPipelineLayout m_PipelineLayout;
+
+    VulkanObjectTracker<VulkanObjectType::PipelineLayout> m_Tracker;
 };
\ No newline at end of file
@@ -0,0 +1,317 @@
+#include "VulkanPipelineLibrary.hpp"
+
+#include "VulkanPipelineLayout.hpp"
+#include "VulkanRenderPass.hpp"
+#include "VulkanShaderModule.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+// Appends values to a byte string. Only fields are written, never whole create infos,
+// so padding and pointers don't end up in the key
+class PipelineKeyWriter
+{
+public:
+    template<typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t size)
+    {
+        m_Key.append(static_cast<const char*>(data), size);
+    }
+
+    void WriteString(const char* string)
+    {
+        size_t length = string ? std::strlen(string) : 0;
+
+        Write(length);
+        WriteBytes(string, length);
+    }
+
+    std::string& GetKey() { return m_Key; }
+
+private:
+    std::string m_Key;
+};
+
+static void WriteStencilOpState(PipelineKeyWriter& writer, const VkStencilOpState& state)
+{
+    writer.Write(state.failOp);
+    writer.Write(state.passOp);
+    writer.Write(state.depthFailOp);
+    writer.Write(state.compareOp);
+    writer.Write(state.compareMask);
+    writer.Write(state.writeMask);
+    writer.Write(state.reference);
+}
+
+static bool IsDynamic(const VkPipelineDynamicStateCreateInfo& dynamicState, VkDynamicState state)
+{
+    return std::find(dynamicState.pDynamicStates, dynamicState.pDynamicStates + dynamicState.dynamicStateCount, state)
+        != dynamicState.pDynamicStates + dynamicState.dynamicStateCount;
+}
+
+VulkanPipelineLibrary::VulkanPipelineLibrary(std::shared_ptr<VulkanDevice> device)
+    : m_Device(device), m_Hits(0), m_Misses(0)
+{
+}
+
+VulkanPipelineLibrary::~VulkanPipelineLibrary()
+{
+}
+
+std::shared_ptr<VulkanGraphicsPipeline> VulkanPipelineLibrary::GetOrCreateGraphicsPipeline(const VulkanGraphicsPipelineDescription& description, bool* created)
+{
+    if(created)
+        *created = false;
+
+    std::string key = BuildKey(description);
+
+    {
+        std::lock_guard lock(m_Mutex);
+
+        auto it = key.empty() ? m_GraphicsPipelines.end() : m_GraphicsPipelines.find(key);
+        if(it != m_GraphicsPipelines.end())
+        {
+            m_Hits++;
+            return it->second.Pipeline;
+        }
+
+        m_Misses++;
+    }
+
+    // Built without holding the lock so other threads can keep looking up pipelines meanwhile
+    std::shared_ptr<VulkanGraphicsPipeline> pipeline = std::make_shared<VulkanGraphicsPipeline>(m_Device, description);
+
+    if(created)
+        *created = true;
+
+    if(key.empty())
+        return pipeline;
+
+    std::lock_guard lock(m_Mutex);
+
+    // Another thread may have built the same pipeline in the meantime, keep the first one
+    auto [it, inserted] = m_GraphicsPipelines.try_emplace(std::move(key), Entry{pipeline, description.RenderPass, description.Layout, description.ShaderModules});
+
+    return it->second.Pipeline;
+}
+
+std::shared_ptr<VulkanGraphicsPipeline> VulkanPipelineLibrary::FindGraphicsPipeline(const VulkanGraphicsPipelineDescription& description)
+{
+    std::string key = BuildKey(description);
+
+    if(key.empty())
+        return nullptr;
+
+    std::lock_guard lock(m_Mutex);
+
+    auto it = m_GraphicsPipelines.find(key);
+    if(it == m_GraphicsPipelines.end())
+        return nullptr;
+
+    // Misses are counted by GetOrCreateGraphicsPipeline, which has to follow a failed lookup
+    m_Hits++;
+    return it->second.Pipeline;
+}
+
+void VulkanPipelineLibrary::Clear()
+{
+    std::lock_guard lock(m_Mutex);
+
+    m_GraphicsPipelines.clear();
+}
+
+VulkanPipelineLibraryStats VulkanPipelineLibrary::GetStats() const
+{
+    std::lock_guard lock(m_Mutex);
+
+    VulkanPipelineLibraryStats stats;
+    stats.Hits = m_Hits;
+    stats.Misses = m_Misses;
+    stats.PipelineCount = static_cast<uint32_t>(m_GraphicsPipelines.size());
+
+    return stats;
+}
+
+void VulkanPipelineLibrary::LogStats() const
+{
+    VulkanPipelineLibraryStats stats = GetStats();
+
+    Log.Info("PipelineLibrary ", stats.PipelineCount, " pipelines, ", stats.Hits, " hits, ", stats.Misses, " misses");
+}
+
+size_t VulkanPipelineLibrary::KeyHash::operator()(const std::string& key) const
+{
+    // FNV-1a, stable across runs and standard libraries unlike std::hash
+    uint64_t hash = 14695981039346656037ull;
+
+    for(char byte : key)
+    {
+        hash ^= static_cast<uint8_t>(byte);
+        hash *= 1099511628211ull;
+    }
+
+    return static_cast<size_t>(hash);
+}
+
+std::string VulkanPipelineLibrary::BuildKey(const VulkanGraphicsPipelineDescription& description)
+{
+    // Extension structs can't be serialized generically, such pipelines bypass the library
+    bool hasExtensions = description.VertexInputState.pNext || description.InputAssemblyState.pNext ||
+        description.ViewportState.pNext || description.RasterizationState.pNext ||
+        description.MultisampleState.pNext || description.DepthStencilState.pNext ||
+        description.ColorBlendState.pNext || description.DynamicState.pNext;
+
+    for(const VulkanPipelineShaderStage& stage : description.ShaderStages)
+        hasExtensions |= stage.pNext != nullptr;
+
+    if(hasExtensions)
+        return {};
+
+    // A module the description doesn't hold could be destroyed and its handle reused while the entry still exists
+    for(const VulkanPipelineShaderStage& stage : description.ShaderStages)
+    {
+        bool held = std::any_of(description.ShaderModules.begin(), description.ShaderModules.end(), [&](const std::shared_ptr<VulkanShaderModule>& module)
+        {
+            return module && module->GetHandle() == stage.module;
+        });
+
+        if(!held)
+            return {};
+    }
+
+    PipelineKeyWriter writer;
+
+    writer.Write(description.ShaderStages.size());
+    for(const VulkanPipelineShaderStage& stage : description.ShaderStages)
+    {
+        writer.Write(stage.flags);
+        writer.Write(stage.stage);
+        writer.Write(stage.module);
+        writer.WriteString(stage.pName);
+
+        const VkSpecializationInfo* specialization = stage.pSpecializationInfo;
+        writer.Write(specialization ? specialization->mapEntryCount : 0u);
+
+        if(specialization)
+        {
+            for(uint32_t i = 0; i < specialization->mapEntryCount; i++)
+            {
+                writer.Write(specialization->pMapEntries[i].constantID);
+                writer.Write(specialization->pMapEntries[i].offset);
+                writer.Write(specialization->pMapEntries[i].size);
+            }
+
+            writer.Write(specialization->dataSize);
+            writer.WriteBytes(specialization->pData, specialization->dataSize);
+        }
+    }
+
+    writer.Write(description.VertexInputState.flags);
+    writer.Write(description.VertexInputState.vertexBindingDescriptionCount);
+    for(uint32_t i = 0; i < description.VertexInputState.vertexBindingDescriptionCount; i++)
+    {
+        const VkVertexInputBindingDescription& binding = description.VertexInputState.pVertexBindingDescriptions[i];
+        writer.Write(binding.binding);
+        writer.Write(binding.stride);
+        writer.Write(binding.inputRate);
+    }
+
+    writer.Write(description.VertexInputState.vertexAttributeDescriptionCount);
+    for(uint32_t i = 0; i < description.VertexInputState.vertexAttributeDescriptionCount; i++)
+    {
+        const VkVertexInputAttributeDescription& attribute = description.VertexInputState.pVertexAttributeDescriptions[i];
+        writer.Write(attribute.location);
+        writer.Write(attribute.binding);
+        writer.Write(attribute.format);
+        writer.Write(attribute.offset);
+    }
+
+    writer.Write(description.InputAssemblyState.flags);
+    writer.Write(description.InputAssemblyState.topology);
+    writer.Write(description.InputAssemblyState.primitiveRestartEnable);
+
+    // Dynamic viewports and scissors are ignored by the driver, leaving them out lets
+    // pipelines that only differ by the swapchain extent share an entry
+    writer.Write(description.ViewportState.flags);
+    writer.Write(description.ViewportState.viewportCount);
+    writer.Write(description.ViewportState.scissorCount);
+
+    if(!IsDynamic(description.DynamicState, VK_DYNAMIC_STATE_VIEWPORT) && description.ViewportState.pViewports)
+        writer.WriteBytes(description.ViewportState.pViewports, sizeof(VkViewport) * description.ViewportState.viewportCount);
+
+    if(!IsDynamic(description.DynamicState, VK_DYNAMIC_STATE_SCISSOR) && description.ViewportState.pScissors)
+        writer.WriteBytes(description.ViewportState.pScissors, sizeof(VkRect2D) * description.ViewportState.scissorCount);
+
+    writer.Write(description.RasterizationState.flags);
+    writer.Write(description.RasterizationState.depthClampEnable);
+    writer.Write(description.RasterizationState.rasterizerDiscardEnable);
+    writer.Write(description.RasterizationState.polygonMode);
+    writer.Write(description.RasterizationState.cullMode);
+    writer.Write(description.RasterizationState.frontFace);
+    writer.Write(description.RasterizationState.depthBiasEnable);
+    writer.Write(description.RasterizationState.depthBiasConstantFactor);
+    writer.Write(description.RasterizationState.depthBiasClamp);
+    writer.Write(description.RasterizationState.depthBiasSlopeFactor);
+    writer.Write(description.RasterizationState.lineWidth);
+
+    writer.Write(description.MultisampleState.flags);
+    writer.Write(description.MultisampleState.rasterizationSamples);
+    writer.Write(description.MultisampleState.sampleShadingEnable);
+    writer.Write(description.MultisampleState.minSampleShading);
+    writer.Write(description.MultisampleState.pSampleMask != nullptr);
+    if(description.MultisampleState.pSampleMask)
+        writer.WriteBytes(description.MultisampleState.pSampleMask, sizeof(VkSampleMask) * ((description.MultisampleState.rasterizationSamples + 31) / 32));
+    writer.Write(description.MultisampleState.alphaToCoverageEnable);
+    writer.Write(description.MultisampleState.alphaToOneEnable);
+
+    writer.Write(description.DepthStencilState.flags);
+    writer.Write(description.DepthStencilState.depthTestEnable);
+    writer.Write(description.DepthStencilState.depthWriteEnable);
+    writer.Write(description.DepthStencilState.depthCompareOp);
+    writer.Write(description.DepthStencilState.depthBoundsTestEnable);
+    writer.Write(description.DepthStencilState.stencilTestEnable);
+    WriteStencilOpState(writer, description.DepthStencilState.front);
+    WriteStencilOpState(writer, description.DepthStencilState.back);
+    writer.Write(description.DepthStencilState.minDepthBounds);
+    writer.Write(description.DepthStencilState.maxDepthBounds);
+
+    writer.Write(description.ColorBlendState.flags);
+    writer.Write(description.ColorBlendState.logicOpEnable);
+    writer.Write(description.ColorBlendState.logicOp);
+    writer.Write(description.ColorBlendState.attachmentCount);
+    for(uint32_t i = 0; i < description.ColorBlendState.attachmentCount; i++)
+    {
+        const VkPipelineColorBlendAttachmentState& attachment = description.ColorBlendState.pAttachments[i];
+        writer.Write(attachment.blendEnable);
+        writer.Write(attachment.srcColorBlendFactor);
+        writer.Write(attachment.dstColorBlendFactor);
+        writer.Write(attachment.colorBlendOp);
+        writer.Write(attachment.srcAlphaBlendFactor);
+        writer.Write(attachment.dstAlphaBlendFactor);
+        writer.Write(attachment.alphaBlendOp);
+        writer.Write(attachment.colorWriteMask);
+    }
+    writer.Write(description.ColorBlendState.blendConstants);
+
+    // Order of dynamic states doesn't matter to the driver
+    std::vector<VkDynamicState> dynamicStates(description.DynamicState.pDynamicStates, description.DynamicState.pDynamicStates + description.DynamicState.dynamicStateCount);
+    std::sort(dynamicStates.begin(), dynamicStates.end());
+
+    writer.Write(description.DynamicState.flags);
+    writer.Write(dynamicStates.size());
+    writer.WriteBytes(dynamicStates.data(), sizeof(VkDynamicState) * dynamicStates.size());
+
+    writer.Write(description.Layout->GetHandle());
+    writer.Write(description.RenderPass->GetHandle());
+    writer.Write(description.Subpass);
+
+    return std::move(writer.GetKey());
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "VulkanGraphicsPipeline.hpp"
+#include "VulkanGraphicsPipelineDescription.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct VulkanPipelineLibraryStats
+{
+    uint32_t Hits = 0;
+    uint32_t Misses = 0;
+    uint32_t PipelineCount = 0;
+};
+
+// Deduplicates pipelines by the state they are built from. Everything reachable from the create info
+// is serialized into a key, so two requests built from separate but equal state objects share a pipeline.
+// Shader modules, the layout and the render pass are keyed by handle, entries hold on to those objects
+// so a handle in a key can't be recycled for a different object
+class VulkanPipelineLibrary
+{
+public:
+    VulkanPipelineLibrary(std::shared_ptr<VulkanDevice> device);
+    ~VulkanPipelineLibrary();
+
+    VulkanPipelineLibrary(const VulkanPipelineLibrary&) = delete;
+    VulkanPipelineLibrary& operator=(const VulkanPipelineLibrary&) = delete;
+
+    // Returns the existing pipeline if one was built from equal state, otherwise builds and keeps it.
+    // |created| is set when this call had to build the pipeline
+    std::shared_ptr<VulkanGraphicsPipeline> GetOrCreateGraphicsPipeline(const VulkanGraphicsPipelineDescription& description, bool* created = nullptr);
+
+    // Returns nullptr instead of building the pipeline when it isn't in the library yet
+    std::shared_ptr<VulkanGraphicsPipeline> FindGraphicsPipeline(const VulkanGraphicsPipelineDescription& description);
+
+    // Drops the library's references, pipelines still held elsewhere stay alive
+    void Clear();
+
+    VulkanPipelineLibraryStats GetStats() const;
+    void LogStats() const;
+
+    // Equal keys mean equal pipelines. Empty if the description can't be keyed
+    static std::string BuildKey(const VulkanGraphicsPipelineDescription& description);
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const std::string& key) const;
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<VulkanGraphicsPipeline> Pipeline;
+
+        // Held so the handles in the key can't be recycled while the entry exists
+        std::shared_ptr<VulkanRenderPass> RenderPass;
+        std::shared_ptr<VulkanPipelineLayout> Layout;
+        std::vector<std::shared_ptr<VulkanShaderModule>> ShaderModules;
+    };
+
+private:
+    std::shared_ptr<VulkanDevice> m_Device;
+
+    std::unordered_map<std::string, Entry, KeyHash> m_GraphicsPipelines;
+
+    uint32_t m_Hits;
+    uint32_t m_Misses;
+
+    mutable std::mutex m_Mutex;
+
+    VulkanObjectTracker<VulkanObjectType::PipelineLibrary> m_Tracker;
+};
@@ -16,7 +16,6 @@ VulkanPipelineVertexInputState::VulkanPipelineVertexInputState()
 {
 }
 
-// INCOMPLETE
 VulkanPipelineVertexInputState::VulkanPipelineVertexInputState
 (
     const std::vector<VulkanVertexInputBindingDescription>& bindings,
@@ -28,8 +27,39 @@ VulkanPipelineVertexInputState::VulkanPipelineVertexInputState
         0,
         static_cast<uint32_t>(bindings.size()),
         VK_NULL_HANDLE,
-        0,
+        static_cast<uint32_t>(attributes.size()),
         VK_NULL_HANDLE
-    }
+    },
+    m_Bindings(bindings.begin(), bindings.end()),
+    m_Attributes(attributes.begin(), attributes.end())
+{
+    pVertexBindingDescriptions = m_Bindings.data();
+    pVertexAttributeDescriptions = m_Attributes.data();
+}
+
+VulkanPipelineVertexInputState::VulkanPipelineVertexInputState
+(
+    const VulkanPipelineVertexInputState& other
+) : VkPipelineVertexInputStateCreateInfo(other),
+    m_Bindings(other.m_Bindings),
+    m_Attributes(other.m_Attributes)
 {
+    pVertexBindingDescriptions = m_Bindings.data();
+    pVertexAttributeDescriptions = m_Attributes.data();
+}
+
+VulkanPipelineVertexInputState& VulkanPipelineVertexInputState::operator=(const VulkanPipelineVertexInputState& other)
+{
+    if(this == &other)
+        return *this;
+
+    VkPipelineVertexInputStateCreateInfo::operator=(other);
+
+    m_Bindings = other.m_Bindings;
+    m_Attributes = other.m_Attributes;
+
+    pVertexBindingDescriptions = m_Bindings.data();
+    pVertexAttributeDescriptions = m_Attributes.data();
+
+    return *this;
 }
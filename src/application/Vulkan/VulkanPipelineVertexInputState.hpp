@@ -17,5 +17,12 @@ public:
         const std::vector<VulkanVertexInputAttributeDescription>& attributes
     );
 
+    VulkanPipelineVertexInputState(const VulkanPipelineVertexInputState& other);
+    VulkanPipelineVertexInputState& operator=(const VulkanPipelineVertexInputState& other);
+
     constexpr operator const VkPipelineVertexInputStateCreateInfo*() const { return this; }
-};
\ No newline at end of file
+
+private:
+    std::vector<VkVertexInputBindingDescription> m_Bindings;
+    std::vector<VkVertexInputAttributeDescription> m_Attributes;
+};
@@ -9,10 +9,38 @@ VulkanPipelineViewportState::VulkanPipelineViewportState
         VK_NULL_HANDLE,
         0,
         1,
-        m_Viewport,
+        VK_NULL_HANDLE,
         1,
-        m_Scissor
+        VK_NULL_HANDLE
     }, m_Viewport(viewport), m_Scissor(scissor)
 {
+    pViewports = m_Viewport;
+    pScissors = m_Scissor;
+}
+
+VulkanPipelineViewportState::VulkanPipelineViewportState
+(
+    const VulkanPipelineViewportState& other
+) : VkPipelineViewportStateCreateInfo(other),
+    m_Viewport(other.m_Viewport),
+    m_Scissor(other.m_Scissor)
+{
+    pViewports = m_Viewport;
+    pScissors = m_Scissor;
+}
+
+VulkanPipelineViewportState& VulkanPipelineViewportState::operator=(const VulkanPipelineViewportState& other)
+{
+    if(this == &other)
+        return *this;
+
+    VkPipelineViewportStateCreateInfo::operator=(other);
+
+    m_Viewport = other.m_Viewport;
+    m_Scissor = other.m_Scissor;
+
+    pViewports = m_Viewport;
+    pScissors = m_Scissor;
+
+    return *this;
 }
-    
\ No newline at end of file
@@ -7,9 +7,11 @@ class VulkanPipelineViewportState : public VkPipelineViewportStateCreateInfo
 {
 public:
     VulkanPipelineViewportState(const VulkanViewport& viewport, const VulkanRect2D& scissor);
+    VulkanPipelineViewportState(const VulkanPipelineViewportState& other);
+    VulkanPipelineViewportState& operator=(const VulkanPipelineViewportState& other);
 
     operator const VkPipelineViewportStateCreateInfo*() const { return this; }
 public:
     VulkanViewport m_Viewport;
     VulkanRect2D m_Scissor;
-};
\ No newline at end of file
+};
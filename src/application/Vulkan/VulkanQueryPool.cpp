@@ -0,0 +1,63 @@
+#include "VulkanQueryPool.hpp"
+
+VulkanQueryPool::VulkanQueryPool(std::shared_ptr<VulkanDevice> device, VkQueryType type, uint32_t queryCount, VkQueryPipelineStatisticFlags pipelineStatistics)
+    : m_Device(device), m_QueryPool(VK_NULL_HANDLE), m_Type(type), m_QueryCount(queryCount)
+{
+    VkQueryPoolCreateInfo createInfo {};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType = type;
+    createInfo.queryCount = queryCount;
+    createInfo.pipelineStatistics = pipelineStatistics;
+
+    VkResult result = vkCreateQueryPool(device->GetHandle(), &createInfo, nullptr, &m_QueryPool);
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error("Failed to create query pool");
+        throw std::runtime_error("Vulkan error");
+    }
+}
+
+VulkanQueryPool::~VulkanQueryPool()
+{
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), queryPool = m_QueryPool]()
+    {
+        vkDestroyQueryPool(device, queryPool, nullptr);
+    });
+}
+
+bool VulkanQueryPool::GetResults(uint32_t firstQuery, uint32_t count, std::vector<uint64_t>& results) const
+{
+    results.assign(count * 2, 0);
+
+    VkResult result = vkGetQueryPoolResults(
+        m_Device->GetHandle(),
+        m_QueryPool,
+        firstQuery,
+        count,
+        results.size() * sizeof(uint64_t),
+        results.data(),
+        2 * sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+    );
+
+    // Not ready still writes the availability of every query
+    if(result != VK_SUCCESS && result != VK_NOT_READY)
+    {
+        Log.Error("Failed to read query pool results");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    for(uint32_t i = 0; i < count; i++)
+    {
+        if(results[i * 2 + 1] != 0)
+            return true;
+    }
+
+    return false;
+}
+
+VkQueryPool VulkanQueryPool::GetHandle() const
+{
+    return m_QueryPool;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+class VulkanQueryPool
+{
+public:
+    VulkanQueryPool(std::shared_ptr<VulkanDevice> device, VkQueryType type, uint32_t queryCount, VkQueryPipelineStatisticFlags pipelineStatistics = 0);
+    ~VulkanQueryPool();
+
+    VulkanQueryPool(const VulkanQueryPool&) = delete;
+    VulkanQueryPool& operator=(const VulkanQueryPool&) = delete;
+
+    // Reads |count| 64 bit results starting at |firstQuery| without waiting. Each result is followed by its
+    // availability, so |results| gets 2 * |count| values. False if none of the queries were available
+    bool GetResults(uint32_t firstQuery, uint32_t count, std::vector<uint64_t>& results) const;
+
+    VkQueryPool GetHandle() const;
+    VkQueryType GetType() const { return m_Type; }
+    uint32_t GetQueryCount() const { return m_QueryCount; }
+
+private:
+    std::shared_ptr<VulkanDevice> m_Device;
+    VkQueryPool m_QueryPool;
+
+    VkQueryType m_Type;
+    uint32_t m_QueryCount;
+
+    VulkanObjectTracker<VulkanObjectType::QueryPool> m_Tracker;
+};
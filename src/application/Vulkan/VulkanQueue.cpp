@@ -5,16 +5,19 @@
 #include "VulkanSemaphore.hpp"
 #include "VulkanFence.hpp"
 #include "VulkanSwapchain.hpp"
+#include "VulkanTimelineSemaphore.hpp"
+#include "VulkanSubmitBatch.hpp"
+#include "../debug/Profiler.hpp"
 
 VulkanQueue::VulkanQueue(VkQueue queue, std::shared_ptr<VulkanDevice> device, uint32_t familyIndex, uint32_t index)
-    : m_Queue(queue), m_Device(device), m_FamilyIndex(familyIndex), m_Index(index)
+    : m_Queue(queue), m_Device(device), m_FamilyIndex(familyIndex), m_Index(index), m_SubmittedValue(0), m_CompletedValue(0)
 {   
-    Log.Info("Queue created");
+    if(m_Device->HasTimelineSemaphores())
+        m_Timeline = std::make_unique<VulkanTimelineSemaphore>(m_Device, 0);
 }
 
 VulkanQueue::~VulkanQueue()
 {
-    Log.Info("Queue destructed");
 }
 
 void VulkanQueue::Submit
@@ -26,22 +29,29 @@ void VulkanQueue::Submit
     VulkanFence* fence
 )
 {
-    VkSemaphore waitSemaphores[] = { waitSemaphore->GetHandle() };
-    VkPipelineStageFlags waitStages[] = {waitStageMask};
-
     VkSubmitInfo submitInfo {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer.GetHandleAddress();
 
-    VkSemaphore signalSemaphores[] = {signalSemaphore->GetHandle()};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
+    VkSemaphore waitSemaphoreHandle = VK_NULL_HANDLE;
+    if(waitSemaphore)
+    {
+        waitSemaphoreHandle = waitSemaphore->GetHandle();
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &waitSemaphoreHandle;
+        submitInfo.pWaitDstStageMask = &waitStageMask;
+    }
+
+    VkSemaphore signalSemaphoreHandle = VK_NULL_HANDLE;
+    if(signalSemaphore)
+    {
+        signalSemaphoreHandle = signalSemaphore->GetHandle();
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &signalSemaphoreHandle;
+    }
 
-    VkResult submitResult = vkQueueSubmit(m_Queue, 1, &submitInfo, fence->GetHandle());
+    VkResult submitResult = vkQueueSubmit(m_Queue, 1, &submitInfo, fence ? fence->GetHandle() : VK_NULL_HANDLE);
 
     if(submitResult != VK_SUCCESS)
     {
@@ -50,15 +60,256 @@ void VulkanQueue::Submit
     }
 }
 
+uint64_t VulkanQueue::Submit(const VulkanSubmitBatch& batch)
+{
+    PROFILE_ZONE("QueueSubmit");
+
+    uint64_t signalValue = m_SubmittedValue + 1;
+
+    // Waits on other queues become plain semaphore waits and the queue's own timeline is signaled last
+    std::vector<VulkanSubmitBatch::Submit> submits = batch.m_Submits;
+
+    for(VulkanSubmitBatch::Submit& submit : submits)
+    {
+        for(const VulkanQueueWait& wait : submit.QueueWaits)
+        {
+            if(wait.Queue->UsesTimelineSemaphore())
+            {
+                submit.Waits.push_back(VulkanSubmitBatch::SemaphoreEntry{wait.Queue->m_Timeline->GetHandle(), wait.Value, wait.StageMask});
+            }
+            else
+            {
+                // Nothing to wait on the GPU with, the work has to be complete before this submission
+                wait.Queue->WaitForValue(wait.Value);
+            }
+        }
+    }
+
+    if(m_Timeline)
+        submits.back().Signals.push_back(VulkanSubmitBatch::SemaphoreEntry{m_Timeline->GetHandle(), signalValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT});
+
+    VkFence fence = VK_NULL_HANDLE;
+    std::unique_ptr<VulkanFence> fallbackFence;
+
+    if(!m_Timeline)
+    {
+        if(m_FreeFences.empty())
+        {
+            fallbackFence = std::make_unique<VulkanFence>(m_Device);
+        }
+        else
+        {
+            fallbackFence = std::move(m_FreeFences.back());
+            m_FreeFences.pop_back();
+        }
+
+        fence = fallbackFence->GetHandle();
+    }
+
+    VkResult submitResult = VK_SUCCESS;
+
+    if(PFN_vkQueueSubmit2KHR queueSubmit2 = m_Device->GetQueueSubmit2())
+    {
+        // Sized up front, the submit infos point into these
+        std::vector<std::vector<VkSemaphoreSubmitInfo>> waitInfos(submits.size());
+        std::vector<std::vector<VkSemaphoreSubmitInfo>> signalInfos(submits.size());
+        std::vector<std::vector<VkCommandBufferSubmitInfo>> commandBufferInfos(submits.size());
+        std::vector<VkSubmitInfo2> submitInfos(submits.size());
+
+        auto toSemaphoreInfo = [](const VulkanSubmitBatch::SemaphoreEntry& entry)
+        {
+            VkSemaphoreSubmitInfo info {};
+            info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            info.semaphore = entry.Semaphore;
+            info.value = entry.Value;
+            info.stageMask = entry.StageMask;
+
+            return info;
+        };
+
+        for(size_t i = 0; i < submits.size(); i++)
+        {
+            for(const VulkanSubmitBatch::SemaphoreEntry& wait : submits[i].Waits)
+                waitInfos[i].push_back(toSemaphoreInfo(wait));
+
+            for(const VulkanSubmitBatch::SemaphoreEntry& signal : submits[i].Signals)
+                signalInfos[i].push_back(toSemaphoreInfo(signal));
+
+            for(VkCommandBuffer commandBuffer : submits[i].CommandBuffers)
+            {
+                VkCommandBufferSubmitInfo info {};
+                info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+                info.commandBuffer = commandBuffer;
+
+                commandBufferInfos[i].push_back(info);
+            }
+
+            submitInfos[i].sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+            submitInfos[i].waitSemaphoreInfoCount = static_cast<uint32_t>(waitInfos[i].size());
+            submitInfos[i].pWaitSemaphoreInfos = waitInfos[i].data();
+            submitInfos[i].commandBufferInfoCount = static_cast<uint32_t>(commandBufferInfos[i].size());
+            submitInfos[i].pCommandBufferInfos = commandBufferInfos[i].data();
+            submitInfos[i].signalSemaphoreInfoCount = static_cast<uint32_t>(signalInfos[i].size());
+            submitInfos[i].pSignalSemaphoreInfos = signalInfos[i].data();
+        }
+
+        submitResult = queueSubmit2(m_Queue, static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), fence);
+    }
+    else
+    {
+        // Binary semaphores ignore their entry in the value arrays
+        std::vector<std::vector<VkSemaphore>> waitSemaphores(submits.size());
+        std::vector<std::vector<uint64_t>> waitValues(submits.size());
+        std::vector<std::vector<VkPipelineStageFlags>> waitStages(submits.size());
+        std::vector<std::vector<VkSemaphore>> signalSemaphores(submits.size());
+        std::vector<std::vector<uint64_t>> signalValues(submits.size());
+        std::vector<VkTimelineSemaphoreSubmitInfo> timelineInfos(submits.size());
+        std::vector<VkSubmitInfo> submitInfos(submits.size());
+
+        for(size_t i = 0; i < submits.size(); i++)
+        {
+            for(const VulkanSubmitBatch::SemaphoreEntry& wait : submits[i].Waits)
+            {
+                waitSemaphores[i].push_back(wait.Semaphore);
+                waitValues[i].push_back(wait.Value);
+
+                // Stages that only exist in synchronization2 are above the 32 bit range
+                waitStages[i].push_back(static_cast<VkPipelineStageFlags>(wait.StageMask));
+            }
+
+            // Legacy signals always happen after all commands, the stage mask has no equivalent
+            for(const VulkanSubmitBatch::SemaphoreEntry& signal : submits[i].Signals)
+            {
+                signalSemaphores[i].push_back(signal.Semaphore);
+                signalValues[i].push_back(signal.Value);
+            }
+
+            timelineInfos[i].sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineInfos[i].waitSemaphoreValueCount = static_cast<uint32_t>(waitValues[i].size());
+            timelineInfos[i].pWaitSemaphoreValues = waitValues[i].data();
+            timelineInfos[i].signalSemaphoreValueCount = static_cast<uint32_t>(signalValues[i].size());
+            timelineInfos[i].pSignalSemaphoreValues = signalValues[i].data();
+
+            submitInfos[i].sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfos[i].pNext = m_Timeline ? &timelineInfos[i] : nullptr;
+            submitInfos[i].waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores[i].size());
+            submitInfos[i].pWaitSemaphores = waitSemaphores[i].data();
+            submitInfos[i].pWaitDstStageMask = waitStages[i].data();
+            submitInfos[i].commandBufferCount = static_cast<uint32_t>(submits[i].CommandBuffers.size());
+            submitInfos[i].pCommandBuffers = submits[i].CommandBuffers.data();
+            submitInfos[i].signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores[i].size());
+            submitInfos[i].pSignalSemaphores = signalSemaphores[i].data();
+        }
+
+        submitResult = vkQueueSubmit(m_Queue, static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), fence);
+    }
+
+    if(submitResult != VK_SUCCESS)
+    {
+        Log.Error("Failed to submit batch of ", batch.GetCommandBufferCount(), " command buffers");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    if(fallbackFence)
+        m_PendingFences.emplace_back(signalValue, std::move(fallbackFence));
+
+    m_SubmittedValue = signalValue;
+
+    return signalValue;
+}
+
+uint64_t VulkanQueue::SubmitTimeline
+(
+    const VulkanCommandBuffer& commandBuffer,
+    VkPipelineStageFlags waitStageMask,
+    VulkanSemaphore* waitSemaphore,
+    VulkanSemaphore* signalSemaphore,
+    const std::vector<VulkanQueueWait>& queueWaits
+)
+{
+    VulkanSubmitBatch batch;
+    batch.AddCommandBuffer(commandBuffer);
+
+    if(waitSemaphore)
+        batch.Wait(*waitSemaphore, waitStageMask);
+
+    if(signalSemaphore)
+        batch.Signal(*signalSemaphore);
+
+    for(const VulkanQueueWait& wait : queueWaits)
+        batch.Wait(*wait.Queue, wait.Value, wait.StageMask);
+
+    return Submit(batch);
+}
+
+void VulkanQueue::WaitForValue(uint64_t value)
+{
+    if(value <= m_CompletedValue)
+        return;
+
+    PROFILE_ZONE("QueueWait");
+
+    if(value > m_SubmittedValue)
+    {
+        Log.Error("Waiting for timeline value ", value, " but only ", m_SubmittedValue, " was submitted");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    if(m_Timeline)
+    {
+        m_Timeline->Wait(value);
+        m_CompletedValue = value;
+        return;
+    }
+
+    while(!m_PendingFences.empty() && m_PendingFences.front().first <= value)
+    {
+        auto& [fenceValue, fence] = m_PendingFences.front();
+
+        fence->Wait();
+        fence->Reset();
+
+        m_CompletedValue = fenceValue;
+        m_FreeFences.push_back(std::move(fence));
+        m_PendingFences.pop_front();
+    }
+}
+
+uint64_t VulkanQueue::GetCompletedValue()
+{
+    if(m_Timeline)
+    {
+        m_CompletedValue = m_Timeline->GetValue();
+        return m_CompletedValue;
+    }
+
+    while(!m_PendingFences.empty() && m_PendingFences.front().second->IsSignaled())
+    {
+        auto& [fenceValue, fence] = m_PendingFences.front();
+
+        fence->Reset();
+
+        m_CompletedValue = fenceValue;
+        m_FreeFences.push_back(std::move(fence));
+        m_PendingFences.pop_front();
+    }
+
+    return m_CompletedValue;
+}
+
 VkResult VulkanQueue::Present(uint32_t imageIndex, const VulkanSwapchain& swapchain, VulkanSemaphore* waitSemaphore)
 {
+    PROFILE_ZONE("QueuePresent");
+
     VkPresentInfoKHR presentInfo {};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+
     if(waitSemaphore)
     {
         presentInfo.waitSemaphoreCount = 1;
-        VkSemaphore semaphore = waitSemaphore->GetHandle();
+        semaphore = waitSemaphore->GetHandle();
         presentInfo.pWaitSemaphores = &semaphore;
     }
     else
@@ -76,4 +327,10 @@ VkResult VulkanQueue::Present(uint32_t imageIndex, const VulkanSwapchain& swapch
     VkResult result = vkQueuePresentKHR(m_Queue, &presentInfo);
 
     return result;
+}
+
+bool VulkanQueue::WaitIdle() const
+{
+    VkResult result = vkQueueWaitIdle(m_Queue);
+    return result == VK_SUCCESS;
 }
\ No newline at end of file
@@ -1,12 +1,29 @@
 #pragma once
 
+#include "VulkanObjectRegistry.hpp"
+
 #include <Vulkan/vulkan.hpp>
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 class VulkanDevice;
 class VulkanCommandBuffer;
 class VulkanSemaphore;
 class VulkanFence;
 class VulkanSwapchain;
+class VulkanTimelineSemaphore;
+class VulkanSubmitBatch;
+class VulkanQueue;
+
+// GPU side dependency on work submitted to another queue
+struct VulkanQueueWait
+{
+    VulkanQueue* Queue = nullptr;
+    uint64_t Value = 0;
+    VkPipelineStageFlags2 StageMask = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT;
+};
 
 class VulkanQueue
 {
@@ -27,6 +44,35 @@ public:
         VulkanSemaphore* waitSemaphore = nullptr
     );
 
+    // Submits the whole batch in one call, through vkQueueSubmit2 when synchronization2 is enabled.
+    // Signals the queue's timeline after the last submit and returns the value like SubmitTimeline
+    uint64_t Submit(const VulkanSubmitBatch& batch);
+
+    // Submits like Submit and advances the queue's timeline. The returned value is reached once the
+    // work has completed, the CPU waits for it through WaitForValue and other queues through |queueWaits|
+    uint64_t SubmitTimeline(
+        const VulkanCommandBuffer& commandBuffer,
+        VkPipelineStageFlags waitStageMask = 0,
+        VulkanSemaphore* waitSemaphore = nullptr,
+        VulkanSemaphore* signalSemaphore = nullptr,
+        const std::vector<VulkanQueueWait>& queueWaits = {}
+    );
+
+    // Blocks until every submission up to |value| has completed. Value 0 never blocks, values that
+    // haven't been submitted yet are an error since nothing would ever signal them
+    void WaitForValue(uint64_t value);
+
+    uint64_t GetSubmittedValue() const { return m_SubmittedValue; }
+    uint64_t GetCompletedValue();
+
+    // Without timeline semaphores the timeline is emulated with a fence per submission,
+    // and waits on other queues are done on the CPU before submitting
+    bool UsesTimelineSemaphore() const { return m_Timeline != nullptr; }
+
+    bool WaitIdle() const;
+
+    uint32_t GetFamilyIndex() const { return m_FamilyIndex; }
+
 private:
     friend class VulkanDevice;
     VulkanQueue(VkQueue queue, std::shared_ptr<VulkanDevice> device, uint32_t familyIndex, uint32_t index);
@@ -37,4 +83,14 @@ private:
 
     uint32_t m_FamilyIndex;
     uint32_t m_Index;
+
+    std::unique_ptr<VulkanTimelineSemaphore> m_Timeline;
+    uint64_t m_SubmittedValue;
+    uint64_t m_CompletedValue;
+
+    // Fence fallback, pending fences are ordered by the value they complete
+    std::deque<std::pair<uint64_t, std::unique_ptr<VulkanFence>>> m_PendingFences;
+    std::vector<std::unique_ptr<VulkanFence>> m_FreeFences;
+
+    VulkanObjectTracker<VulkanObjectType::Queue> m_Tracker;
 };
\ No newline at end of file
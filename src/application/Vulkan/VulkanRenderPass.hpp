@@ -4,6 +4,7 @@
 #include "VulkanAttachmentDescription.hpp"
 #include "VulkanSubpassDescription.hpp"
 #include "VulkanSubpassDependency.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 class VulkanRenderPass
 {
@@ -31,4 +32,6 @@ private:
     std::shared_ptr<VulkanDevice> m_Device;
     
     VkRenderPass m_RenderPass;
+
+    VulkanObjectTracker<VulkanObjectType::RenderPass> m_Tracker;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 class VulkanSemaphore
 {
@@ -13,4 +14,6 @@ public:
 private:
     std::shared_ptr<VulkanDevice> m_Device;
     VkSemaphore m_Semaphore;
+
+    VulkanObjectTracker<VulkanObjectType::Semaphore> m_Tracker;
 };
\ No newline at end of file
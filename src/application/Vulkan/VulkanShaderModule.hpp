@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 #include <Vulkan/vulkan.hpp>
 
@@ -19,4 +20,6 @@ public:
 private:
     std::shared_ptr<VulkanDevice> m_Device;
     VkShaderModule m_ShaderModule;
+
+    VulkanObjectTracker<VulkanObjectType::ShaderModule> m_Tracker;
 };
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "VulkanSubmitBatch.hpp"
+
+#include "VulkanCommandBuffer.hpp"
+#include "VulkanSemaphore.hpp"
+#include "VulkanTimelineSemaphore.hpp"
+
+VulkanSubmitBatch::VulkanSubmitBatch()
+    : m_Submits(1)
+{
+}
+
+VulkanSubmitBatch& VulkanSubmitBatch::NextSubmit()
+{
+    // An empty submit in between would only cost the driver time
+    if(!m_Submits.back().CommandBuffers.empty() || !m_Submits.back().Signals.empty())
+        m_Submits.emplace_back();
+
+    return *this;
+}
+
+VulkanSubmitBatch& VulkanSubmitBatch::AddCommandBuffer(const VulkanCommandBuffer& commandBuffer)
+{
+    m_Submits.back().CommandBuffers.push_back(commandBuffer.GetHandle());
+    return *this;
+}
+
+VulkanSubmitBatch& VulkanSubmitBatch::Wait(const VulkanSemaphore& semaphore, VkPipelineStageFlags2 stageMask)
+{
+    m_Submits.back().Waits.push_back(SemaphoreEntry{semaphore.GetHandle(), 0, stageMask});
+    return *this;
+}
+
+VulkanSubmitBatch& VulkanSubmitBatch::Wait(const VulkanTimelineSemaphore& semaphore, uint64_t value, VkPipelineStageFlags2 stageMask)
+{
+    m_Submits.back().Waits.push_back(SemaphoreEntry{semaphore.GetHandle(), value, stageMask});
+    return *this;
+}
+
+VulkanSubmitBatch& VulkanSubmitBatch::Wait(VulkanQueue& queue, uint64_t value, VkPipelineStageFlags2 stageMask)
+{
+    m_Submits.back().QueueWaits.push_back(VulkanQueueWait{&queue, value, stageMask});
+    return *this;
+}
+
+VulkanSubmitBatch& VulkanSubmitBatch::Signal(const VulkanSemaphore& semaphore, VkPipelineStageFlags2 stageMask)
+{
+    m_Submits.back().Signals.push_back(SemaphoreEntry{semaphore.GetHandle(), 0, stageMask});
+    return *this;
+}
+
+VulkanSubmitBatch& VulkanSubmitBatch::Signal(const VulkanTimelineSemaphore& semaphore, uint64_t value, VkPipelineStageFlags2 stageMask)
+{
+    m_Submits.back().Signals.push_back(SemaphoreEntry{semaphore.GetHandle(), value, stageMask});
+    return *this;
+}
+
+void VulkanSubmitBatch::Clear()
+{
+    m_Submits.clear();
+    m_Submits.emplace_back();
+}
+
+bool VulkanSubmitBatch::IsEmpty() const
+{
+    for(const Submit& submit : m_Submits)
+    {
+        if(!submit.CommandBuffers.empty() || !submit.Waits.empty() || !submit.Signals.empty() || !submit.QueueWaits.empty())
+            return false;
+    }
+
+    return true;
+}
+
+uint32_t VulkanSubmitBatch::GetCommandBufferCount() const
+{
+    uint32_t count = 0;
+
+    for(const Submit& submit : m_Submits)
+        count += static_cast<uint32_t>(submit.CommandBuffers.size());
+
+    return count;
+}
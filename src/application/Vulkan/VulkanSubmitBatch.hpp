@@ -0,0 +1,62 @@
+#pragma once
+
+#include "VulkanQueue.hpp"
+
+#include <vector>
+
+class VulkanCommandBuffer;
+class VulkanSemaphore;
+class VulkanTimelineSemaphore;
+
+// Collects command buffers and the semaphores around them so a whole frame goes to the queue in one call.
+// Everything added lands in the current submit, NextSubmit starts another one within the same call when
+// some command buffers have to wait on semaphores the earlier ones don't. Handles are captured when added,
+// the objects only have to stay alive until the batch is submitted
+class VulkanSubmitBatch
+{
+public:
+    VulkanSubmitBatch();
+
+    VulkanSubmitBatch& NextSubmit();
+
+    VulkanSubmitBatch& AddCommandBuffer(const VulkanCommandBuffer& commandBuffer);
+
+    VulkanSubmitBatch& Wait(const VulkanSemaphore& semaphore, VkPipelineStageFlags2 stageMask);
+    VulkanSubmitBatch& Wait(const VulkanTimelineSemaphore& semaphore, uint64_t value, VkPipelineStageFlags2 stageMask);
+
+    // Waits for |value| of another queue's timeline, see VulkanQueue::SubmitTimeline
+    VulkanSubmitBatch& Wait(VulkanQueue& queue, uint64_t value, VkPipelineStageFlags2 stageMask);
+
+    VulkanSubmitBatch& Signal(const VulkanSemaphore& semaphore, VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    VulkanSubmitBatch& Signal(const VulkanTimelineSemaphore& semaphore, uint64_t value, VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    void Clear();
+
+    bool IsEmpty() const;
+    uint32_t GetCommandBufferCount() const;
+
+private:
+    friend class VulkanQueue;
+
+    struct SemaphoreEntry
+    {
+        VkSemaphore Semaphore;
+
+        // Ignored for binary semaphores
+        uint64_t Value;
+
+        VkPipelineStageFlags2 StageMask;
+    };
+
+    struct Submit
+    {
+        std::vector<VkCommandBuffer> CommandBuffers;
+        std::vector<SemaphoreEntry> Waits;
+        std::vector<SemaphoreEntry> Signals;
+
+        // Resolved at submission, the queue may not have a timeline semaphore to wait on
+        std::vector<VulkanQueueWait> QueueWaits;
+    };
+
+    std::vector<Submit> m_Submits;
+};
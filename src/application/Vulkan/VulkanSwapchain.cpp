@@ -1,13 +1,14 @@
 #include "VulkanDevice.hpp"
 #include "VulkanSwapchain.hpp"
 #include "VulkanSemaphore.hpp"
+#include "../debug/Profiler.hpp"
 
 #include <limits>
 
-VulkanSwapchain::VulkanSwapchain(std::shared_ptr<VulkanDevice> device, VkSurfaceKHR surface, const VulkanSwapchainPreferences& preferences)
+VulkanSwapchain::VulkanSwapchain(std::shared_ptr<VulkanDevice> device, VkSurfaceKHR surface, const VulkanSwapchainPreferences& preferences, const VulkanSwapchain* oldSwapchain)
     : m_Device(device)
 {
-    SwapchainSupportDetails swapchainSupport = m_Device->GetSwapchainSupportDetails(surface);
+    const SwapchainSupportDetails& swapchainSupport = m_Device->GetSwapchainSupportDetails(surface);
 
     m_SurfaceFormat = SelectSurfaceFormat(surface, preferences.SurfaceFormat);
     m_PresentMode = SelectPresentMode(surface, preferences.PresentMode);
@@ -44,30 +45,32 @@ VulkanSwapchain::VulkanSwapchain(std::shared_ptr<VulkanDevice> device, VkSurface
     createInfo.compositeAlpha = preferences.CompositeAlpha;
     createInfo.presentMode = m_PresentMode;
     createInfo.clipped = preferences.ClipObscured;
-    createInfo.oldSwapchain = VK_NULL_HANDLE;
+    createInfo.oldSwapchain = oldSwapchain ? oldSwapchain->GetHandle() : VK_NULL_HANDLE;
 
     if(vkCreateSwapchainKHR(m_Device->GetHandle(), &createInfo, nullptr, &m_Swapchain) != VK_SUCCESS)
     {
-        Log.Error("Failed to create swap chain");
+        LOG_ERROR(Swapchain, "Failed to create swap chain");
         throw std::runtime_error("Vulkan error");
     }
 
-    Log.Info("Swapchain created successfully");
-
     m_ImageCount = QueryImageCount();
 
     FetchSwapchainImages();
+
+    LOG_DEBUG(VulkanLifetime, "Swapchain created [", m_Extent.width, ", ", m_Extent.height, "] with ", m_ImageCount, " images");
 }
 
 VulkanSwapchain::~VulkanSwapchain()
 {
-    vkDestroySwapchainKHR(m_Device->GetHandle(), m_Swapchain, nullptr);
-    Log.Info("Swapchain destructed");
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), swapchain = m_Swapchain]()
+    {
+        vkDestroySwapchainKHR(device, swapchain, nullptr);
+    });
 }
 
-std::shared_ptr<VulkanSwapchain> VulkanSwapchain::Create(std::shared_ptr<VulkanDevice> device, VkSurfaceKHR surface, const VulkanSwapchainPreferences& preferences)
+std::shared_ptr<VulkanSwapchain> VulkanSwapchain::Create(std::shared_ptr<VulkanDevice> device, VkSurfaceKHR surface, const VulkanSwapchainPreferences& preferences, const VulkanSwapchain* oldSwapchain)
 {
-    return std::make_shared<VulkanSwapchain>(device, surface, preferences);
+    return std::make_shared<VulkanSwapchain>(device, surface, preferences, oldSwapchain);
 }
 
 std::vector<std::shared_ptr<VulkanSwapchainImage>> VulkanSwapchain::GetSwapchainImages() const
@@ -84,7 +87,7 @@ uint32_t VulkanSwapchain::QueryImageCount() const
 
     if(operationResult != VK_SUCCESS)
     {
-        Log.Error("VkGetSwapchainImagesKHR #1 failed");
+        LOG_ERROR(Swapchain, "VkGetSwapchainImagesKHR #1 failed");
         throw std::runtime_error("Vulkan error");
     }
 
@@ -95,11 +98,11 @@ VkSurfaceFormatKHR VulkanSwapchain::SelectSurfaceFormat(const VkSurfaceKHR surfa
 {
     VkSurfaceFormatKHR result;
 
-    std::vector<VkSurfaceFormatKHR> formats = m_Device->GetSwapchainSupportDetails(surface).Formats;
+    const std::vector<VkSurfaceFormatKHR>& formats = m_Device->GetSwapchainSupportDetails(surface).Formats;
 
     if(formats.empty())
     {
-        Log.Error("No VkSurfaceFormatKHR available");
+        LOG_ERROR(Swapchain, "No VkSurfaceFormatKHR available");
         throw std::runtime_error("Vulkan error");
     }
 
@@ -107,12 +110,12 @@ VkSurfaceFormatKHR VulkanSwapchain::SelectSurfaceFormat(const VkSurfaceKHR surfa
     {
         if(value.format == preference.format && value.colorSpace == preference.colorSpace)
         {
-            Log.Info("Preferred VkSurfaceFormatKHR selected");
+            LOG_INFO(Swapchain, "Preferred VkSurfaceFormatKHR selected");
             return value;
         }
     }
     
-    Log.Info("Using first available VkSurfaceFormatKHR");
+    LOG_INFO(Swapchain, "Using first available VkSurfaceFormatKHR");
     return formats[0];
 }
 
@@ -120,11 +123,11 @@ VkPresentModeKHR VulkanSwapchain::SelectPresentMode(const VkSurfaceKHR surface,
 {
     VkPresentModeKHR result;
 
-    auto presentModes = m_Device->GetSwapchainSupportDetails(surface).PresentModes;
+    const auto& presentModes = m_Device->GetSwapchainSupportDetails(surface).PresentModes;
 
     if(presentModes.empty())
     {
-        Log.Error("No VkPresentModeKHR available");
+        LOG_ERROR(Swapchain, "No VkPresentModeKHR available");
         throw std::runtime_error("Vulkan error");
     }
 
@@ -132,12 +135,12 @@ VkPresentModeKHR VulkanSwapchain::SelectPresentMode(const VkSurfaceKHR surface,
     {
         if(value == preference)
         {
-            Log.Info("Preferred VkPresentModeKHR selected");
+            LOG_INFO(Swapchain, "Preferred VkPresentModeKHR selected");
             return value;
         }
     }
 
-    Log.Info("Using VK_PRESENT_MODE_FIFO_KHR as VkPresentModeKHR");
+    LOG_INFO(Swapchain, "Using VK_PRESENT_MODE_FIFO_KHR as VkPresentModeKHR");
     return VK_PRESENT_MODE_FIFO_KHR;
 }
 
@@ -151,7 +154,7 @@ VkExtent2D VulkanSwapchain::SelectExtent(const VkSurfaceKHR surface, const Vulka
     }
 
     if(preferences.WindowSizeInPixels.width == 0 || preferences.WindowSizeInPixels.height == 0)
-        Log.Warn("VulkanSwapchainPreferences WindowSizeInPixels width and or height is 0");
+        LOG_WARN(Swapchain, "VulkanSwapchainPreferences WindowSizeInPixels width and or height is 0");
 
     VkExtent2D extent = preferences.WindowSizeInPixels;
 
@@ -186,13 +189,13 @@ void VulkanSwapchain::FetchSwapchainImages()
 
     if(operationResult != VK_SUCCESS)
     {
-        Log.Error("VkGetSwapchainImagesKHR #1 failed");
+        LOG_ERROR(Swapchain, "VkGetSwapchainImagesKHR #1 failed");
         throw std::runtime_error("Vulkan error");
     }
 
     if(imageCount == 0)
     {
-        Log.Error("Zero swapchain images available");
+        LOG_ERROR(Swapchain, "Zero swapchain images available");
         throw std::runtime_error("Vulkan error");
     }
     
@@ -201,7 +204,7 @@ void VulkanSwapchain::FetchSwapchainImages()
 
     if(operationResult != VK_SUCCESS)
     {
-        Log.Error("VkGetSwapchainImagesKHR #2 failed");
+        LOG_ERROR(Swapchain, "VkGetSwapchainImagesKHR #2 failed");
         throw std::runtime_error("Vulkan error");
     }
 
@@ -213,12 +216,15 @@ void VulkanSwapchain::FetchSwapchainImages()
 
 VulkanSwapchain::AcquisitionResult VulkanSwapchain::AcquireNextImage(const VulkanSemaphore* semaphore) const
 {
+    PROFILE_ZONE("AcquireNextImage");
+
     uint32_t imageIndex;
     VkResult result = vkAcquireNextImageKHR(m_Device->GetHandle(), m_Swapchain, UINT64_MAX, (semaphore ? semaphore->GetHandle() : VK_NULL_HANDLE), VK_NULL_HANDLE, &imageIndex);
     
-    if(result != VK_SUCCESS)
+    // Out of date and suboptimal are expected while resizing, the caller recreates the swapchain
+    if(result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR)
     {
-        Log.Error("Failed to acquire next swapchain image");
+        LOG_ERROR(Swapchain, "Failed to acquire next swapchain image");
     }
 
     return { result, imageIndex };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanSwapchainImage.hpp"
+#include "VulkanObjectRegistry.hpp"
 
 #include <Vulkan/vulkan.hpp>
 
@@ -54,10 +55,12 @@ public:
         uint32_t ImageIndex;
     };
 
-    VulkanSwapchain(std::shared_ptr<VulkanDevice> device, VkSurfaceKHR surface, const VulkanSwapchainPreferences& preferences);
+    // Passing |oldSwapchain| retires it: images already acquired from it can still be presented, but it can't
+    // acquire new ones. It has to be kept alive until the frames that used it have completed
+    VulkanSwapchain(std::shared_ptr<VulkanDevice> device, VkSurfaceKHR surface, const VulkanSwapchainPreferences& preferences, const VulkanSwapchain* oldSwapchain = nullptr);
     ~VulkanSwapchain();
     
-    static std::shared_ptr<VulkanSwapchain> Create(std::shared_ptr<VulkanDevice> device, VkSurfaceKHR surface, const VulkanSwapchainPreferences& preferences);
+    static std::shared_ptr<VulkanSwapchain> Create(std::shared_ptr<VulkanDevice> device, VkSurfaceKHR surface, const VulkanSwapchainPreferences& preferences, const VulkanSwapchain* oldSwapchain = nullptr);
     
     std::shared_ptr<VulkanDevice> GetDevice() const { return m_Device; }
     VkSwapchainKHR GetHandle() const { return m_Swapchain; }
@@ -86,4 +89,6 @@ private:
 
     std::shared_ptr<VulkanDevice> m_Device;
     std::vector<std::shared_ptr<VulkanSwapchainImage>> m_SwapchainImages;
+
+    VulkanObjectTracker<VulkanObjectType::Swapchain> m_Tracker;
 };  
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "VulkanTimelineSemaphore.hpp"
+
+VulkanTimelineSemaphore::VulkanTimelineSemaphore(std::shared_ptr<VulkanDevice> device, uint64_t initialValue)
+    : m_Device(device), m_Semaphore(VK_NULL_HANDLE)
+{
+    VkSemaphoreTypeCreateInfo typeInfo {};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = initialValue;
+
+    VkSemaphoreCreateInfo semaphoreInfo {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    VkResult result = vkCreateSemaphore(device->GetHandle(), &semaphoreInfo, nullptr, &m_Semaphore);
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error("Failed to create timeline semaphore");
+        throw std::runtime_error("Vulkan error");
+    }
+}
+
+VulkanTimelineSemaphore::~VulkanTimelineSemaphore()
+{
+    m_Device->GetDeletionQueue().Enqueue([device = m_Device->GetHandle(), semaphore = m_Semaphore]()
+    {
+        vkDestroySemaphore(device, semaphore, nullptr);
+    });
+}
+
+VkSemaphore VulkanTimelineSemaphore::GetHandle() const
+{
+    return m_Semaphore;
+}
+
+uint64_t VulkanTimelineSemaphore::GetValue() const
+{
+    uint64_t value = 0;
+    VkResult result = vkGetSemaphoreCounterValue(m_Device->GetHandle(), m_Semaphore, &value);
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error("Failed to read timeline semaphore value");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    return value;
+}
+
+bool VulkanTimelineSemaphore::Wait(uint64_t value, uint64_t timeout) const
+{
+    VkSemaphoreWaitInfo waitInfo {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_Semaphore;
+    waitInfo.pValues = &value;
+
+    VkResult result = vkWaitSemaphores(m_Device->GetHandle(), &waitInfo, timeout);
+
+    if(result != VK_SUCCESS && result != VK_TIMEOUT)
+    {
+        Log.Error("Failed to wait for timeline semaphore");
+        throw std::runtime_error("Vulkan error");
+    }
+
+    return result == VK_SUCCESS;
+}
+
+void VulkanTimelineSemaphore::Signal(uint64_t value)
+{
+    VkSemaphoreSignalInfo signalInfo {};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+    signalInfo.semaphore = m_Semaphore;
+    signalInfo.value = value;
+
+    VkResult result = vkSignalSemaphore(m_Device->GetHandle(), &signalInfo);
+
+    if(result != VK_SUCCESS)
+    {
+        Log.Error("Failed to signal timeline semaphore");
+        throw std::runtime_error("Vulkan error");
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "VulkanDevice.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+// Semaphore carrying a 64 bit counter instead of a signaled flag. Signals only ever raise the value,
+// so waiting for value N also covers every earlier signal. Needs a device with timeline semaphores enabled
+class VulkanTimelineSemaphore
+{
+public:
+    VulkanTimelineSemaphore(std::shared_ptr<VulkanDevice> device, uint64_t initialValue = 0);
+    ~VulkanTimelineSemaphore();
+
+    VkSemaphore GetHandle() const;
+
+    // Highest value signaled so far, by the host or a queue
+    uint64_t GetValue() const;
+
+    // False on timeout
+    bool Wait(uint64_t value, uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
+
+    void Signal(uint64_t value);
+
+private:
+    std::shared_ptr<VulkanDevice> m_Device;
+    VkSemaphore m_Semaphore;
+
+    VulkanObjectTracker<VulkanObjectType::TimelineSemaphore> m_Tracker;
+};
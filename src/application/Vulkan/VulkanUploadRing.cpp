@@ -0,0 +1,183 @@
+#include "VulkanUploadRing.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+VulkanUploadRing::VulkanUploadRing
+(
+    std::shared_ptr<VulkanDevice> device,
+    uint32_t frameCount,
+    VkDeviceSize bytesPerFrame,
+    VkBufferUsageFlags usage,
+    VulkanUploadRingOverflowPolicy overflowPolicy
+) : m_Device(device),
+    m_Usage(usage),
+    m_OverflowPolicy(overflowPolicy),
+    m_FrameIndex(0),
+    m_Head(0),
+    m_FrameStats(frameCount),
+    m_Overflow(frameCount)
+{
+    const VkPhysicalDeviceLimits& limits = device->GetPhysicalDevice()->GetProperties().limits;
+
+    m_MinAlignment = std::max({
+        limits.minUniformBufferOffsetAlignment,
+        limits.minStorageBufferOffsetAlignment,
+        limits.nonCoherentAtomSize,
+        VkDeviceSize(16)
+    });
+
+    m_OffsetAlignment = 16;
+
+    if(usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+        m_OffsetAlignment = std::max(m_OffsetAlignment, limits.minUniformBufferOffsetAlignment);
+
+    if(usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+        m_OffsetAlignment = std::max(m_OffsetAlignment, limits.minStorageBufferOffsetAlignment);
+
+    if(usage & (VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT))
+        m_OffsetAlignment = std::max(m_OffsetAlignment, limits.minTexelBufferOffsetAlignment);
+
+    m_BytesPerFrame = AlignUp(bytesPerFrame, m_MinAlignment);
+
+    // Prefer memory the GPU reads fast (BAR / unified memory) that doesn't need explicit flushes
+    m_Buffer = std::make_unique<VulkanBuffer>(
+        device,
+        m_BytesPerFrame * frameCount,
+        usage,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    );
+}
+
+VulkanUploadRing::~VulkanUploadRing()
+{
+}
+
+void VulkanUploadRing::BeginFrame(uint32_t frameIndex)
+{
+    m_FrameIndex = frameIndex;
+    m_Head = 0;
+
+    // The fence of this frame has signaled so the GPU is done with its overflow buffers too
+    m_Overflow[frameIndex].Head = 0;
+    m_Overflow[frameIndex].Retired.clear();
+    m_FrameStats[frameIndex].BytesAllocated = 0;
+}
+
+VulkanUploadAllocation VulkanUploadRing::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    alignment = std::max(alignment, m_OffsetAlignment);
+
+    VkDeviceSize offset = AlignUp(m_Head, alignment);
+
+    if(offset + size > m_BytesPerFrame)
+    {
+        m_FrameStats[m_FrameIndex].OverflowCount++;
+
+        switch(m_OverflowPolicy)
+        {
+            case VulkanUploadRingOverflowPolicy::ReturnNull:
+                return VulkanUploadAllocation{};
+            case VulkanUploadRingOverflowPolicy::OverflowBuffer:
+                return AllocateOverflow(size, alignment);
+            case VulkanUploadRingOverflowPolicy::Throw:
+                Log.Error("UploadRing frame region of ", m_BytesPerFrame, " bytes exhausted");
+                throw std::runtime_error("Vulkan error");
+        }
+    }
+
+    m_Head = offset + size;
+
+    VulkanUploadRingFrameStats& stats = m_FrameStats[m_FrameIndex];
+    stats.BytesAllocated = m_Head;
+    stats.HighWaterMark = std::max(stats.HighWaterMark, m_Head);
+
+    VkDeviceSize bufferOffset = m_FrameIndex * m_BytesPerFrame + offset;
+
+    VulkanUploadAllocation allocation;
+    allocation.Buffer = m_Buffer.get();
+    allocation.Offset = bufferOffset;
+    allocation.Size = size;
+    allocation.Data = static_cast<char*>(m_Buffer->GetMappedData()) + bufferOffset;
+
+    return allocation;
+}
+
+VulkanUploadAllocation VulkanUploadRing::Upload(const void* data, VkDeviceSize size, VkDeviceSize alignment)
+{
+    VulkanUploadAllocation allocation = Allocate(size, alignment);
+
+    if(allocation)
+        std::memcpy(allocation.Data, data, size);
+
+    return allocation;
+}
+
+void VulkanUploadRing::Flush()
+{
+    if(m_Head > 0)
+        m_Buffer->Flush(m_FrameIndex * m_BytesPerFrame, m_Head);
+
+    OverflowRegion& overflow = m_Overflow[m_FrameIndex];
+
+    if(overflow.Head > 0)
+        overflow.Buffer->Flush(0, overflow.Head);
+
+    for(auto& buffer : overflow.Retired)
+        buffer->Flush();
+}
+
+void VulkanUploadRing::LogStats() const
+{
+    for(size_t i = 0; i < m_FrameStats.size(); i++)
+    {
+        const VulkanUploadRingFrameStats& stats = m_FrameStats[i];
+
+        Log.Info("UploadRing frame[", i, "] high water mark ", stats.HighWaterMark, "/", m_BytesPerFrame, " bytes, ", stats.OverflowCount, " overflows");
+
+        if(stats.OverflowCount > 0)
+            Log.Warn("UploadRing frame[", i, "] overflowed, consider a larger ring");
+    }
+}
+
+VulkanUploadAllocation VulkanUploadRing::AllocateOverflow(VkDeviceSize size, VkDeviceSize alignment)
+{
+    OverflowRegion& overflow = m_Overflow[m_FrameIndex];
+
+    VkDeviceSize offset = AlignUp(overflow.Head, alignment);
+
+    if(!overflow.Buffer || offset + size > overflow.Buffer->GetSize())
+    {
+        // Doubling keeps a frame that keeps overflowing down to a few buffers until it settles on one
+        VkDeviceSize capacity = std::max(size, overflow.Buffer ? overflow.Buffer->GetSize() * 2 : m_BytesPerFrame);
+
+        if(overflow.Buffer)
+            overflow.Retired.push_back(std::move(overflow.Buffer));
+
+        overflow.Buffer = std::make_unique<VulkanBuffer>(
+            m_Device,
+            capacity,
+            m_Usage,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+        );
+
+        offset = 0;
+    }
+
+    overflow.Head = offset + size;
+
+    VulkanUploadAllocation allocation;
+    allocation.Buffer = overflow.Buffer.get();
+    allocation.Offset = offset;
+    allocation.Size = size;
+    allocation.Data = static_cast<char*>(overflow.Buffer->GetMappedData()) + offset;
+
+    return allocation;
+}
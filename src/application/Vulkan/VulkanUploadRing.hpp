@@ -0,0 +1,104 @@
+#pragma once
+
+#include "VulkanBuffer.hpp"
+#include "VulkanObjectRegistry.hpp"
+
+#include <vector>
+
+enum class VulkanUploadRingOverflowPolicy
+{
+    // Allocate returns an empty allocation, the caller decides what to skip
+    ReturnNull,
+
+    // Spill into an overflow buffer of the frame. It is kept and reused once the frame comes around again,
+    // and only replaced by a larger one when it runs out too
+    OverflowBuffer,
+
+    Throw
+};
+
+struct VulkanUploadAllocation
+{
+    const VulkanBuffer* Buffer = nullptr;
+    VkDeviceSize Offset = 0;
+    VkDeviceSize Size = 0;
+    void* Data = nullptr;
+
+    explicit operator bool() const { return Data != nullptr; }
+};
+
+struct VulkanUploadRingFrameStats
+{
+    VkDeviceSize BytesAllocated = 0;
+    VkDeviceSize HighWaterMark = 0;
+    uint32_t OverflowCount = 0;
+};
+
+// One persistently mapped host visible buffer split into a region per frame in flight.
+// Allocations are bump allocated and the whole region is reclaimed in BeginFrame, which
+// must only be called once the fence of the frame that last used |frameIndex| has signaled
+class VulkanUploadRing
+{
+public:
+    VulkanUploadRing(
+        std::shared_ptr<VulkanDevice> device,
+        uint32_t frameCount,
+        VkDeviceSize bytesPerFrame,
+        VkBufferUsageFlags usage,
+        VulkanUploadRingOverflowPolicy overflowPolicy = VulkanUploadRingOverflowPolicy::OverflowBuffer
+    );
+
+    ~VulkanUploadRing();
+
+    VulkanUploadRing(const VulkanUploadRing&) = delete;
+    VulkanUploadRing& operator=(const VulkanUploadRing&) = delete;
+
+    void BeginFrame(uint32_t frameIndex);
+
+    VulkanUploadAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment = 16);
+    VulkanUploadAllocation Upload(const void* data, VkDeviceSize size, VkDeviceSize alignment = 16);
+
+    // Makes the current frame's writes visible to the device. Call before submitting
+    void Flush();
+
+    const VulkanUploadRingFrameStats& GetFrameStats(uint32_t frameIndex) const { return m_FrameStats[frameIndex]; }
+    void LogStats() const;
+
+    const VulkanBuffer& GetBuffer() const { return *m_Buffer; }
+    VkDeviceSize GetBytesPerFrame() const { return m_BytesPerFrame; }
+
+private:
+    VulkanUploadAllocation AllocateOverflow(VkDeviceSize size, VkDeviceSize alignment);
+
+private:
+    std::shared_ptr<VulkanDevice> m_Device;
+    std::unique_ptr<VulkanBuffer> m_Buffer;
+
+    VkBufferUsageFlags m_Usage;
+    VulkanUploadRingOverflowPolicy m_OverflowPolicy;
+
+    VkDeviceSize m_BytesPerFrame;
+
+    // Every region starts at a multiple of this so any usage's offset alignment holds
+    VkDeviceSize m_MinAlignment;
+
+    // Least alignment of an allocation, the offset limits of the ring's usage
+    VkDeviceSize m_OffsetAlignment;
+
+    uint32_t m_FrameIndex;
+    VkDeviceSize m_Head;
+
+    std::vector<VulkanUploadRingFrameStats> m_FrameStats;
+    struct OverflowRegion
+    {
+        std::unique_ptr<VulkanBuffer> Buffer;
+        VkDeviceSize Head = 0;
+
+        // Outgrown this frame but still referenced by its allocations
+        std::vector<std::unique_ptr<VulkanBuffer>> Retired;
+    };
+
+    std::vector<OverflowRegion> m_Overflow;
+
+    VulkanObjectTracker<VulkanObjectType::UploadRing> m_Tracker;
+};
@@ -0,0 +1,212 @@
+#include "VulkanValidationAggregator.hpp"
+#include "../debug/Log.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+static const char* VALIDATION_PREFIX = "Vulkan validation layer: ";
+
+// Layers and the loader may send different messages under the same id, 0 in particular, so the name is part of the key
+// and messages without an id are told apart by their text
+static std::string BuildMessageKey(int32_t messageId, const char* messageIdName, const char* message)
+{
+    std::string key = std::to_string(messageId) + ":" + messageIdName;
+
+    if(messageId == 0)
+        key += ":" + std::to_string(std::hash<std::string_view>{}(message));
+
+    return key;
+}
+
+VulkanValidationAggregator::VulkanValidationAggregator(const VulkanValidationAggregatorCreateInfo& createInfo)
+    : m_MessagesBeforeSuppression(createInfo.MessagesBeforeSuppression),
+    m_SummaryInterval(createInfo.SummaryInterval),
+    m_LastSummary(std::chrono::steady_clock::now()),
+    m_MessageCount(0),
+    m_SuppressedCount(0)
+{
+}
+
+void VulkanValidationAggregator::Report
+(
+    VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+    VkDebugUtilsMessageTypeFlagsEXT type,
+    const VkDebugUtilsMessengerCallbackDataEXT& callbackData
+)
+{
+    const char* message = callbackData.pMessage ? callbackData.pMessage : "";
+    const char* messageIdName = callbackData.pMessageIdName ? callbackData.pMessageIdName : "";
+
+    std::string key = BuildMessageKey(callbackData.messageIdNumber, messageIdName, message);
+
+    std::lock_guard lock(m_Mutex);
+
+    m_MessageCount++;
+
+    if(type & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
+    {
+        VulkanPerformanceWarning& warning = m_PerformanceWarnings[key];
+
+        if(warning.Count++ == 0)
+        {
+            warning.MessageId = callbackData.messageIdNumber;
+            warning.MessageIdName = messageIdName;
+            warning.FirstMessage = message;
+        }
+    }
+
+    MessageEntry& entry = m_Messages[key];
+
+    if(entry.Count++ == 0)
+    {
+        entry.MessageId = callbackData.messageIdNumber;
+        entry.MessageIdName = messageIdName;
+        entry.Severity = severity;
+    }
+
+    if(entry.Count <= m_MessagesBeforeSuppression)
+    {
+        LogMessage(severity, message);
+
+        if(entry.Count == m_MessagesBeforeSuppression)
+            Log.Info(VALIDATION_PREFIX, messageIdName, " seen ", entry.Count, " times, only counting it from now on");
+    }
+    else
+    {
+        entry.Suppressed++;
+        m_SuppressedCount++;
+    }
+
+    if(std::chrono::steady_clock::now() - m_LastSummary >= m_SummaryInterval)
+        FlushLocked();
+}
+
+void VulkanValidationAggregator::Flush()
+{
+    std::lock_guard lock(m_Mutex);
+    FlushLocked();
+}
+
+void VulkanValidationAggregator::FlushLocked()
+{
+    m_LastSummary = std::chrono::steady_clock::now();
+
+    for(auto& [key, entry] : m_Messages)
+    {
+        if(entry.Suppressed == 0)
+            continue;
+
+        std::string summary = entry.MessageIdName + " repeated " + std::to_string(entry.Suppressed) + " more times, " + std::to_string(entry.Count) + " in total";
+        LogMessage(entry.Severity, summary.c_str());
+
+        entry.Suppressed = 0;
+    }
+}
+
+void VulkanValidationAggregator::LogSummary() const
+{
+    std::lock_guard lock(m_Mutex);
+
+    Log.Info("Validation messages ", m_MessageCount, " total, ", m_SuppressedCount, " suppressed, ", m_Messages.size(), " distinct");
+
+    for(const auto& [key, entry] : m_Messages)
+        Log.Info("    ", entry.MessageIdName, " (", entry.MessageId, ") ", entry.Count);
+
+    if(m_PerformanceWarnings.empty())
+        return;
+
+    Log.Info("Performance warnings");
+    for(const auto& [key, warning] : m_PerformanceWarnings)
+        Log.Info("    ", warning.MessageIdName, " (", warning.MessageId, ") ", warning.Count);
+}
+
+bool VulkanValidationAggregator::ExportPerformanceWarnings(const std::string& path) const
+{
+    std::vector<VulkanPerformanceWarning> warnings;
+
+    {
+        std::lock_guard lock(m_Mutex);
+
+        for(const auto& [key, warning] : m_PerformanceWarnings)
+            warnings.push_back(warning);
+    }
+
+    std::sort(warnings.begin(), warnings.end(), [](const VulkanPerformanceWarning& lhs, const VulkanPerformanceWarning& rhs)
+    {
+        return lhs.Count > rhs.Count;
+    });
+
+    std::ofstream file(path);
+
+    if(!file.is_open())
+    {
+        Log.Error("Failed to open ", path, " for writing");
+        return false;
+    }
+
+    auto quote = [](const std::string& text)
+    {
+        std::string quoted = "\"";
+
+        for(char c : text)
+        {
+            if(c == '"')
+                quoted.push_back('"');
+
+            quoted.push_back(c);
+        }
+
+        return quoted + "\"";
+    };
+
+    file << "message_id,message_id_name,count,first_message\n";
+
+    for(const VulkanPerformanceWarning& warning : warnings)
+        file << warning.MessageId << "," << quote(warning.MessageIdName) << "," << warning.Count << "," << quote(warning.FirstMessage) << "\n";
+
+    Log.Info("Wrote ", warnings.size(), " performance warnings to ", path);
+    return true;
+}
+
+uint64_t VulkanValidationAggregator::GetMessageCount() const
+{
+    std::lock_guard lock(m_Mutex);
+    return m_MessageCount;
+}
+
+uint64_t VulkanValidationAggregator::GetSuppressedCount() const
+{
+    std::lock_guard lock(m_Mutex);
+    return m_SuppressedCount;
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL VulkanValidationAggregator::Callback
+(
+    VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+    VkDebugUtilsMessageTypeFlagsEXT messageType,
+    const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+    void* pUserData
+)
+{
+    static_cast<VulkanValidationAggregator*>(pUserData)->Report(messageSeverity, messageType, *pCallbackData);
+
+    return VK_FALSE;
+}
+
+void VulkanValidationAggregator::LogMessage(VkDebugUtilsMessageSeverityFlagBitsEXT severity, const char* message)
+{
+    switch(severity)
+    {
+        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
+            Log.Error(VALIDATION_PREFIX, message);
+        break;
+        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
+            Log.Warn(VALIDATION_PREFIX, message);
+        break;
+        default:
+            Log.Info(VALIDATION_PREFIX, message);
+        break;
+    }
+}
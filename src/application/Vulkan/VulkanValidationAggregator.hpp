@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Vulkan/vulkan.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct VulkanValidationAggregatorCreateInfo
+{
+    // Occurrences of a message logged in full before it is only counted
+    uint32_t MessagesBeforeSuppression = 3;
+
+    // How often suppressed messages get a line saying how many more came in
+    std::chrono::seconds SummaryInterval = std::chrono::seconds(5);
+};
+
+struct VulkanPerformanceWarning
+{
+    int32_t MessageId = 0;
+    std::string MessageIdName;
+    uint64_t Count = 0;
+
+    // Message of the first occurrence, later ones usually only differ in handles
+    std::string FirstMessage;
+};
+
+// Groups debug utils messages by messageIdNumber and pMessageIdName so a message repeated every frame is logged a few times and
+// then summarized periodically. Performance warnings are kept in a table of their own which can be exported.
+// Messages may come from any thread that calls into Vulkan
+class VulkanValidationAggregator
+{
+public:
+    VulkanValidationAggregator(const VulkanValidationAggregatorCreateInfo& createInfo = {});
+
+    void Report(
+        VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+        VkDebugUtilsMessageTypeFlagsEXT type,
+        const VkDebugUtilsMessengerCallbackDataEXT& callbackData
+    );
+
+    // Logs the counts of everything suppressed since the last summary, whether or not the interval has passed
+    void Flush();
+
+    // Totals per message id and the performance warning table
+    void LogSummary() const;
+
+    // Performance warnings as CSV, most frequent first. Returns false if the file couldn't be written
+    bool ExportPerformanceWarnings(const std::string& path) const;
+
+    uint64_t GetMessageCount() const;
+    uint64_t GetSuppressedCount() const;
+
+    // Usable as the messenger callback with the aggregator as user data
+    static VKAPI_ATTR VkBool32 VKAPI_CALL Callback(
+        VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+        VkDebugUtilsMessageTypeFlagsEXT messageType,
+        const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+        void* pUserData
+    );
+
+private:
+    struct MessageEntry
+    {
+        int32_t MessageId = 0;
+        std::string MessageIdName;
+        VkDebugUtilsMessageSeverityFlagBitsEXT Severity;
+        uint64_t Count = 0;
+
+        // Counted but not logged since the last summary
+        uint64_t Suppressed = 0;
+    };
+
+    void FlushLocked();
+    static void LogMessage(VkDebugUtilsMessageSeverityFlagBitsEXT severity, const char* message);
+
+private:
+    uint32_t m_MessagesBeforeSuppression;
+    std::chrono::seconds m_SummaryInterval;
+
+    mutable std::mutex m_Mutex;
+    // Keyed by id, name and for id 0 a hash of the message, see BuildMessageKey
+    std::unordered_map<std::string, MessageEntry> m_Messages;
+    std::unordered_map<std::string, VulkanPerformanceWarning> m_PerformanceWarnings;
+    std::chrono::steady_clock::time_point m_LastSummary;
+
+    uint64_t m_MessageCount;
+    uint64_t m_SuppressedCount;
+};
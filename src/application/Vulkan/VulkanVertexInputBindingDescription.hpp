@@ -2,7 +2,7 @@
 
 #include <Vulkan/vulkan.hpp>
 
-class VulkanVertexInputBindingDescription : VkVertexInputBindingDescription
+class VulkanVertexInputBindingDescription : public VkVertexInputBindingDescription
 {
 public:
     VulkanVertexInputBindingDescription(
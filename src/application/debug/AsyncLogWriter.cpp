@@ -0,0 +1,281 @@
+#include "AsyncLogWriter.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+
+static std::terminate_handler s_PreviousTerminateHandler = nullptr;
+
+AsyncLogWriter& AsyncLogWriter::Get()
+{
+    // Never destroyed, lines logged by static destructors after Shutdown still go somewhere
+    static AsyncLogWriter* writer = []()
+    {
+        AsyncLogWriter* instance = new AsyncLogWriter(13);
+
+        std::atexit([]() { Get().Shutdown(); });
+
+        s_PreviousTerminateHandler = std::set_terminate(OnTerminate);
+
+        for(int signal : { SIGSEGV, SIGABRT, SIGFPE, SIGILL })
+            std::signal(signal, OnCrashSignal);
+
+        return instance;
+    }();
+
+    return *writer;
+}
+
+AsyncLogWriter::AsyncLogWriter(uint32_t capacityLog2)
+    : m_Mask((1ull << capacityLog2) - 1),
+    m_Slots(std::make_unique<Slot[]>(1ull << capacityLog2)),
+    m_EnqueuePosition(0),
+    m_DequeuePosition(0),
+    m_Written(0),
+    m_Policy(LogOverflowPolicy::Drop),
+    m_Dropped(0),
+    m_ReportedDropped(0),
+    m_Running(true),
+    m_Sleeping(false)
+{
+    for(uint64_t i = 0; i <= m_Mask; i++)
+        m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+
+    m_Thread = std::thread(&AsyncLogWriter::Run, this);
+}
+
+void AsyncLogWriter::Push(std::ostream& stream, LogLevel level, std::string&& text)
+{
+    if(!TryPush(stream, text))
+    {
+        if(level != LogLevel::Error && m_Policy.load(std::memory_order_relaxed) == LogOverflowPolicy::Drop)
+        {
+            m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        while(!TryPush(stream, text))
+        {
+            // Nobody is left to make room
+            if(!m_Running.load(std::memory_order_acquire))
+                Drain();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    // After Shutdown the writer thread is gone and the line would sit in the queue forever
+    if(!m_Running.load(std::memory_order_acquire))
+        Drain();
+}
+
+void AsyncLogWriter::Flush()
+{
+    uint64_t target = m_EnqueuePosition.load(std::memory_order_acquire);
+
+    while(m_Written.load(std::memory_order_acquire) < target)
+    {
+        if(!m_Running.load(std::memory_order_acquire))
+            Drain();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void AsyncLogWriter::Shutdown()
+{
+    if(!m_Running.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    {
+        std::lock_guard lock(m_WakeMutex);
+        m_Wake.notify_one();
+    }
+
+    if(m_Thread.joinable())
+        m_Thread.join();
+
+    Drain();
+}
+
+bool AsyncLogWriter::TryPush(std::ostream& stream, std::string& text)
+{
+    uint64_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+
+    for(;;)
+    {
+        Slot& slot = m_Slots[position & m_Mask];
+        uint64_t sequence = slot.Sequence.load(std::memory_order_acquire);
+        int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+
+        if(difference == 0)
+        {
+            if(m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.Stream = &stream;
+                slot.Text = std::move(text);
+                slot.Sequence.store(position + 1, std::memory_order_release);
+
+                WakeIfSleeping();
+                return true;
+            }
+        }
+        else if(difference < 0)
+        {
+            // The writer hasn't freed this slot yet, the queue is full
+            return false;
+        }
+        else
+        {
+            position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t AsyncLogWriter::Drain()
+{
+    while(m_Draining.test_and_set(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    size_t written = DrainLocked();
+
+    m_Draining.clear(std::memory_order_release);
+
+    return written;
+}
+
+size_t AsyncLogWriter::DrainLocked()
+{
+    std::string batch;
+    std::ostream* batchStream = nullptr;
+    size_t written = 0;
+
+    auto writeBatch = [&]()
+    {
+        if(batchStream && !batch.empty())
+        {
+            batchStream->write(batch.data(), batch.size());
+            batchStream->flush();
+        }
+
+        batch.clear();
+    };
+
+    for(;;)
+    {
+        Slot& slot = m_Slots[m_DequeuePosition & m_Mask];
+
+        if(slot.Sequence.load(std::memory_order_acquire) != m_DequeuePosition + 1)
+            break;
+
+        if(slot.Stream != batchStream)
+        {
+            writeBatch();
+            batchStream = slot.Stream;
+        }
+
+        uint64_t dropped = m_Dropped.load(std::memory_order_relaxed);
+        if(dropped != m_ReportedDropped)
+        {
+            batch += "Warn: " + std::to_string(dropped - m_ReportedDropped) + " log messages dropped, the queue was full\n";
+            m_ReportedDropped = dropped;
+        }
+
+        batch += slot.Text;
+        slot.Text.clear();
+
+        slot.Sequence.store(m_DequeuePosition + m_Mask + 1, std::memory_order_release);
+        m_DequeuePosition++;
+        written++;
+    }
+
+    writeBatch();
+
+    m_Written.fetch_add(written, std::memory_order_release);
+
+    return written;
+}
+
+void AsyncLogWriter::WakeIfSleeping()
+{
+    if(!m_Sleeping.load(std::memory_order_relaxed))
+        return;
+
+    std::lock_guard lock(m_WakeMutex);
+
+    if(m_Sleeping.exchange(false, std::memory_order_relaxed))
+        m_Wake.notify_one();
+}
+
+void AsyncLogWriter::Run()
+{
+    // Polls while lines keep coming, waking the writer for every line would be a syscall per line. After the
+    // queue stayed empty for a while it sleeps until a producer wakes it, so an idle process doesn't wake up
+    // hundreds of times a second. The timeout covers a line pushed just as the writer went to sleep
+    const auto POLL_INTERVAL = std::chrono::milliseconds(2);
+    const uint32_t POLLS_BEFORE_SLEEPING = 25;
+    const auto SLEEP_TIMEOUT = std::chrono::milliseconds(250);
+
+    uint32_t emptyPolls = 0;
+
+    while(m_Running.load(std::memory_order_acquire))
+    {
+        if(Drain() > 0)
+        {
+            emptyPolls = 0;
+            continue;
+        }
+
+        if(++emptyPolls < POLLS_BEFORE_SLEEPING)
+        {
+            std::this_thread::sleep_for(POLL_INTERVAL);
+            continue;
+        }
+
+        std::unique_lock lock(m_WakeMutex);
+        m_Sleeping.store(true, std::memory_order_relaxed);
+
+        m_Wake.wait_for(lock, SLEEP_TIMEOUT, [this]()
+        {
+            const Slot& next = m_Slots[m_DequeuePosition & m_Mask];
+
+            return !m_Sleeping.load(std::memory_order_relaxed) || !m_Running.load(std::memory_order_acquire)
+                || next.Sequence.load(std::memory_order_acquire) == m_DequeuePosition + 1;
+        });
+
+        m_Sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+void AsyncLogWriter::OnCrashSignal(int signal)
+{
+    AsyncLogWriter& writer = Get();
+
+    // The writer thread may be stuck mid batch in the crashed state, don't wait on it for long. Without the flag
+    // the queue is left alone, draining next to the writer could write lines twice or tear the output
+    bool acquired = false;
+    for(int attempt = 0; attempt < 1000 && !acquired; attempt++)
+    {
+        acquired = !writer.m_Draining.test_and_set(std::memory_order_acquire);
+
+        if(!acquired)
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    if(acquired)
+        writer.DrainLocked();
+
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+void AsyncLogWriter::OnTerminate()
+{
+    Get().Flush();
+
+    if(s_PreviousTerminateHandler)
+        s_PreviousTerminateHandler();
+
+    std::abort();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+// Values match the LOG_LEVEL_* build flags in Log.hpp
+enum class LogLevel : uint8_t
+{
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+
+    // Only meaningful as a filter threshold, nothing is logged at this level
+    Off
+};
+
+enum class LogOverflowPolicy
+{
+    // A full queue drops the message, the writer later reports how many went missing
+    Drop,
+
+    // A full queue makes the producer wait for the writer to catch up
+    Block
+};
+
+// Bounded multi producer, single consumer queue of finished log lines, drained by a background thread
+// in batches. Producers only claim a slot and move their line in, they never touch the output stream,
+// so logging costs them no syscalls and no stream lock
+class AsyncLogWriter
+{
+public:
+    static AsyncLogWriter& Get();
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    // Errors always block, losing one is worse than stalling a frame
+    void Push(std::ostream& stream, LogLevel level, std::string&& text);
+
+    // Returns once everything pushed so far has been written
+    void Flush();
+
+    // Writes out what is queued and stops the writer thread. Whatever is logged afterwards is written by the caller
+    void Shutdown();
+
+    void SetOverflowPolicy(LogOverflowPolicy policy) { m_Policy.store(policy, std::memory_order_relaxed); }
+    LogOverflowPolicy GetOverflowPolicy() const { return m_Policy.load(std::memory_order_relaxed); }
+
+    uint64_t GetDroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+private:
+    AsyncLogWriter(uint32_t capacityLog2);
+
+    struct Slot
+    {
+        // Equals the enqueue position once the slot may be written, position + 1 once it holds a line
+        std::atomic<uint64_t> Sequence;
+
+        std::ostream* Stream;
+        std::string Text;
+    };
+
+    bool TryPush(std::ostream& stream, std::string& text);
+
+    // Writes out everything queued, returns the number of lines written. Only one thread drains at a time
+    size_t Drain();
+    size_t DrainLocked();
+
+    void Run();
+
+    // Lets a producer wake the writer thread once it went to sleep on an empty queue
+    void WakeIfSleeping();
+
+    // Last chance to get queued lines out before the process dies
+    static void OnCrashSignal(int signal);
+    static void OnTerminate();
+
+private:
+    uint64_t m_Mask;
+    std::unique_ptr<Slot[]> m_Slots;
+
+    alignas(64) std::atomic<uint64_t> m_EnqueuePosition;
+    alignas(64) uint64_t m_DequeuePosition;
+    std::atomic<uint64_t> m_Written;
+
+    std::atomic_flag m_Draining;
+
+    std::atomic<LogOverflowPolicy> m_Policy;
+    std::atomic<uint64_t> m_Dropped;
+    uint64_t m_ReportedDropped;
+
+    std::atomic<bool> m_Running;
+    std::thread m_Thread;
+
+    // Set while the writer waits on m_Wake, only then does a producer pay for a notify
+    std::atomic<bool> m_Sleeping;
+    std::mutex m_WakeMutex;
+    std::condition_variable m_Wake;
+};
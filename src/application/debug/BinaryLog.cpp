@@ -0,0 +1,210 @@
+#include "BinaryLog.hpp"
+
+template<typename T>
+static void Append(std::vector<uint8_t>& out, const T& value)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+static void AppendString(std::vector<uint8_t>& out, const char* text)
+{
+    uint16_t length = static_cast<uint16_t>(std::min<size_t>(std::strlen(text), UINT16_MAX));
+
+    Append(out, length);
+    out.insert(out.end(), text, text + length);
+}
+
+void BinaryLogThreadBuffer::Consume(std::vector<uint8_t>& out)
+{
+    uint64_t head = m_Head.load(std::memory_order_acquire);
+    uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+
+    for(uint64_t position = tail; position < head; )
+    {
+        size_t offset = static_cast<size_t>(position & m_Mask);
+        size_t count = static_cast<size_t>(std::min<uint64_t>(head - position, m_Data.size() - offset));
+
+        out.insert(out.end(), m_Data.begin() + offset, m_Data.begin() + offset + count);
+        position += count;
+    }
+
+    m_Tail.store(head, std::memory_order_release);
+
+    if(head != tail)
+        RequestTimestamp();
+}
+
+BinaryLog& BinaryLog::Get()
+{
+    static BinaryLog log;
+    return log;
+}
+
+BinaryLog::BinaryLog()
+    : m_Epoch(std::chrono::steady_clock::now()), m_WrittenSites(0), m_ReportedDropped(0), m_Running(false)
+{
+}
+
+BinaryLog::~BinaryLog()
+{
+    Close();
+}
+
+bool BinaryLog::Open(const std::string& path)
+{
+    Close();
+
+    {
+        std::lock_guard lock(m_Mutex);
+
+        m_File.open(path, std::ios::binary | std::ios::trunc);
+        if(!m_File.is_open())
+        {
+            Log.Error("Failed to open ", path, " for binary logging");
+            return false;
+        }
+
+        m_File.write(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+        m_Epoch = std::chrono::steady_clock::now();
+        m_WrittenSites = 0;
+
+        // The decoder needs two calibration points, this one and the last drain's
+        std::vector<uint8_t> block;
+        WriteCalibration(block);
+        m_File.write(reinterpret_cast<const char*>(block.data()), block.size());
+
+        // Threads that logged into a previous file continue from their last timestamp, which isn't in this one
+        for(auto& thread : m_Threads)
+            thread->RequestTimestamp();
+    }
+
+    m_Running.store(true, std::memory_order_release);
+    m_Thread = std::thread(&BinaryLog::Run, this);
+
+    s_Active.store(true, std::memory_order_release);
+
+    Log.Info("Binary log writing to ", path);
+    return true;
+}
+
+void BinaryLog::Close()
+{
+    s_Active.store(false, std::memory_order_release);
+
+    if(!m_Running.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    if(m_Thread.joinable())
+        m_Thread.join();
+
+    Drain();
+
+    std::lock_guard lock(m_Mutex);
+    m_File.close();
+}
+
+uint64_t BinaryLog::GetDroppedCount()
+{
+    std::lock_guard lock(m_Mutex);
+
+    uint64_t dropped = 0;
+    for(auto& thread : m_Threads)
+        dropped += thread->GetDroppedCount();
+
+    return dropped;
+}
+
+BinaryLogThreadBuffer& BinaryLog::CreateThreadBuffer()
+{
+    std::lock_guard lock(m_Mutex);
+
+    // Buffers outlive their threads so the writer still gets the last records of finished threads
+    m_Threads.emplace_back(std::make_unique<BinaryLogThreadBuffer>(static_cast<uint32_t>(m_Threads.size() + 1), THREAD_CAPACITY_LOG2));
+
+    return *m_Threads.back();
+}
+
+void BinaryLog::RegisterSite(BinaryLogSite& site, const BinaryLogArgType* types, uint8_t argCount)
+{
+    std::lock_guard lock(m_Mutex);
+
+    // Another thread may have won the race
+    if(site.Registered.load(std::memory_order_relaxed))
+        return;
+
+    std::vector<uint8_t> block;
+    Append(block, BinaryLogBlock::Site);
+    Append(block, site.Id);
+    Append(block, site.Level);
+    Append(block, static_cast<uint32_t>(site.Category));
+    Append(block, site.Line);
+    AppendString(block, site.File);
+    AppendString(block, site.Format);
+    Append(block, argCount);
+    block.insert(block.end(), reinterpret_cast<const uint8_t*>(types), reinterpret_cast<const uint8_t*>(types) + argCount);
+
+    m_Sites.push_back(std::move(block));
+
+    site.Registered.store(true, std::memory_order_release);
+}
+
+void BinaryLog::Run()
+{
+    while(m_Running.load(std::memory_order_acquire))
+    {
+        Drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+void BinaryLog::Drain()
+{
+    std::lock_guard lock(m_Mutex);
+
+    if(!m_File.is_open())
+        return;
+
+    // Sites first, every record drained below was written after its site registered
+    for(; m_WrittenSites < m_Sites.size(); m_WrittenSites++)
+        m_File.write(reinterpret_cast<const char*>(m_Sites[m_WrittenSites].data()), m_Sites[m_WrittenSites].size());
+
+    std::vector<uint8_t> block;
+    WriteCalibration(block);
+
+    uint64_t dropped = 0;
+    std::vector<uint8_t> records;
+
+    for(auto& thread : m_Threads)
+    {
+        dropped += thread->GetDroppedCount();
+
+        records.clear();
+        thread->Consume(records);
+
+        if(records.empty())
+            continue;
+
+        Append(block, BinaryLogBlock::Records);
+        Append(block, thread->GetThreadId());
+        Append(block, static_cast<uint32_t>(records.size()));
+        block.insert(block.end(), records.begin(), records.end());
+    }
+
+    if(dropped != m_ReportedDropped)
+    {
+        Append(block, BinaryLogBlock::Dropped);
+        Append(block, dropped);
+        m_ReportedDropped = dropped;
+    }
+
+    m_File.write(reinterpret_cast<const char*>(block.data()), block.size());
+    m_File.flush();
+}
+
+void BinaryLog::WriteCalibration(std::vector<uint8_t>& block)
+{
+    Append(block, BinaryLogBlock::Calibration);
+    Append(block, BinaryLogTicks());
+    Append(block, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Epoch).count()));
+}
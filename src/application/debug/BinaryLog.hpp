@@ -0,0 +1,326 @@
+#pragma once
+
+#include "BinaryLogFormat.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define BINARY_LOG_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define BINARY_LOG_HAS_TSC 1
+#else
+    #define BINARY_LOG_HAS_TSC 0
+#endif
+
+// Raw timestamp of a record, converted to time by the decoder using the calibration blocks
+inline uint64_t BinaryLogTicks()
+{
+    #if BINARY_LOG_HAS_TSC
+        return __rdtsc();
+    #else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+}
+
+// FNV-1a, evaluated at compile time for the site ids
+constexpr uint32_t BinaryLogHash(const char* text, uint32_t line)
+{
+    uint32_t hash = 2166136261u ^ line;
+
+    for(; *text; text++)
+        hash = (hash ^ static_cast<uint8_t>(*text)) * 16777619u;
+
+    return hash != BINARY_LOG_TIMESTAMP_ID ? hash : 1;
+}
+
+template<typename T>
+constexpr BinaryLogArgType BinaryLogArgTypeOf()
+{
+    using U = std::decay_t<T>;
+
+    if constexpr(std::is_same_v<U, bool>)
+        return BinaryLogArgType::Bool;
+    else if constexpr(std::is_enum_v<U>)
+        return BinaryLogArgType::Int64;
+    else if constexpr(std::is_integral_v<U>)
+        return std::is_signed_v<U> ? BinaryLogArgType::Int64 : BinaryLogArgType::UInt64;
+    else if constexpr(std::is_floating_point_v<U>)
+        return BinaryLogArgType::Double;
+    else if constexpr(std::is_convertible_v<const U&, std::string_view>)
+        return BinaryLogArgType::String;
+    else
+        static_assert(sizeof(U) == 0, "Binary log arguments are numbers, enums and strings");
+}
+
+// One per call site, constant initialized so using it costs no guard
+struct BinaryLogSite
+{
+    uint32_t Id;
+    LogLevel Level;
+    LogCategory Category;
+    const char* File;
+    uint32_t Line;
+    const char* Format;
+
+    std::atomic<bool> Registered = false;
+};
+
+// Records of a single thread. Only the owning thread writes and only the log's writer thread reads,
+// a full buffer drops new records rather than waiting
+class BinaryLogThreadBuffer
+{
+public:
+    BinaryLogThreadBuffer(uint32_t threadId, uint32_t capacityLog2)
+        : m_ThreadId(threadId), m_Mask((1ull << capacityLog2) - 1), m_Data(1ull << capacityLog2), m_CachedTail(0),
+        m_UntimedRecords(BINARY_LOG_TIMESTAMP_INTERVAL), m_Head(0), m_Tail(0), m_Drained(false), m_Dropped(0) {}
+
+    // Every BINARY_LOG_TIMESTAMP_INTERVAL records, and after a drain so records written now and then don't
+    // get the time of one from long ago
+    bool IsTimestampDue() const
+    {
+        return m_UntimedRecords >= BINARY_LOG_TIMESTAMP_INTERVAL || m_Drained.load(std::memory_order_relaxed);
+    }
+
+    // Returns false when |size| bytes don't fit, |position| is where the record starts
+    bool Reserve(size_t size, uint64_t& position)
+    {
+        position = m_Head.load(std::memory_order_relaxed);
+
+        // The writer's tail is only looked at when the last one seen says the buffer is full,
+        // that keeps its cache line from bouncing on every record
+        if(m_Data.size() - (position - m_CachedTail) >= size)
+            return true;
+
+        m_CachedTail = m_Tail.load(std::memory_order_acquire);
+        if(m_Data.size() - (position - m_CachedTail) >= size)
+            return true;
+
+        m_Dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void Put(uint64_t& position, const void* data, size_t size)
+    {
+        size_t offset = static_cast<size_t>(position & m_Mask);
+        position += size;
+
+        // Sizes are mostly constants, so the common case turns into a plain store
+        if(offset + size <= m_Data.size())
+        {
+            std::memcpy(m_Data.data() + offset, data, size);
+            return;
+        }
+
+        size_t first = m_Data.size() - offset;
+        std::memcpy(m_Data.data() + offset, data, first);
+        std::memcpy(m_Data.data(), static_cast<const uint8_t*>(data) + first, size - first);
+    }
+
+    // Publishes everything put since Reserve
+    void Commit(uint64_t position, bool timestamped)
+    {
+        if(!timestamped)
+            m_UntimedRecords++;
+        else
+        {
+            // The timestamped record is the first of the interval
+            m_UntimedRecords = 1;
+
+            if(m_Drained.load(std::memory_order_relaxed))
+                m_Drained.store(false, std::memory_order_relaxed);
+        }
+
+        m_Head.store(position, std::memory_order_release);
+    }
+
+    // Appends the committed bytes to |out| and frees them. Writer thread only
+    void Consume(std::vector<uint8_t>& out);
+
+    // Makes the next record carry a timestamp
+    void RequestTimestamp() { m_Drained.store(true, std::memory_order_relaxed); }
+
+    uint32_t GetThreadId() const { return m_ThreadId; }
+    uint64_t GetDroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+private:
+    uint32_t m_ThreadId;
+    uint64_t m_Mask;
+    std::vector<uint8_t> m_Data;
+    uint64_t m_CachedTail;
+    uint32_t m_UntimedRecords;
+
+    alignas(64) std::atomic<uint64_t> m_Head;
+    alignas(64) std::atomic<uint64_t> m_Tail;
+    std::atomic<bool> m_Drained;
+    std::atomic<uint64_t> m_Dropped;
+};
+
+// Logs format ids and raw argument bytes instead of text. The call site copies a few words into a per thread
+// buffer and moves on without reading the clock most of the time, a background thread writes the buffers to disk
+// and tools/logdecode turns the file back into text. Meant for logging that happens too often for the text logger,
+// ie. every frame
+class BinaryLog
+{
+public:
+    static BinaryLog& Get();
+
+    BinaryLog(const BinaryLog&) = delete;
+    BinaryLog& operator=(const BinaryLog&) = delete;
+
+    // Starts writing to |path|. Returns false if the file couldn't be opened
+    bool Open(const std::string& path);
+
+    // Writes out everything buffered and closes the file
+    void Close();
+
+    static bool IsActive() { return s_Active.load(std::memory_order_relaxed); }
+
+    template<typename ... Args>
+    void Write(BinaryLogSite& site, const Args& ... args)
+    {
+        if(!site.Registered.load(std::memory_order_acquire))
+        {
+            static constexpr BinaryLogArgType types[] = { BinaryLogArgTypeOf<Args>()..., BinaryLogArgType::Int64 };
+            RegisterSite(site, types, sizeof...(Args));
+        }
+
+        BinaryLogThreadBuffer& buffer = GetThreadBuffer();
+
+        bool timestamped = buffer.IsTimestampDue();
+        size_t size = sizeof(site.Id) + (EncodedSize(args) + ... + 0);
+
+        if(timestamped)
+            size += sizeof(BINARY_LOG_TIMESTAMP_ID) + sizeof(uint64_t);
+
+        uint64_t position;
+        if(!buffer.Reserve(size, position))
+            return;
+
+        if(timestamped)
+        {
+            uint64_t ticks = BinaryLogTicks();
+            buffer.Put(position, &BINARY_LOG_TIMESTAMP_ID, sizeof(BINARY_LOG_TIMESTAMP_ID));
+            buffer.Put(position, &ticks, sizeof(ticks));
+        }
+
+        buffer.Put(position, &site.Id, sizeof(site.Id));
+        (Encode(buffer, position, args), ...);
+
+        buffer.Commit(position, timestamped);
+    }
+
+    uint64_t GetDroppedCount();
+
+private:
+    BinaryLog();
+    ~BinaryLog();
+
+    BinaryLogThreadBuffer& GetThreadBuffer()
+    {
+        if(!t_Buffer)
+            t_Buffer = &CreateThreadBuffer();
+
+        return *t_Buffer;
+    }
+
+    BinaryLogThreadBuffer& CreateThreadBuffer();
+
+    void RegisterSite(BinaryLogSite& site, const BinaryLogArgType* types, uint8_t argCount);
+
+    void Run();
+
+    // Writes pending sites, a calibration block and every thread's records. Writer thread or Close only
+    void Drain();
+
+    void WriteCalibration(std::vector<uint8_t>& block);
+
+    template<typename T>
+    static size_t EncodedSize(const T& value)
+    {
+        if constexpr(BinaryLogArgTypeOf<T>() == BinaryLogArgType::String)
+            return sizeof(uint16_t) + std::min<size_t>(std::string_view(value).size(), BINARY_LOG_MAX_STRING);
+        else
+            return sizeof(uint64_t);
+    }
+
+    template<typename T>
+    static void Encode(BinaryLogThreadBuffer& buffer, uint64_t& position, const T& value)
+    {
+        constexpr BinaryLogArgType type = BinaryLogArgTypeOf<T>();
+
+        if constexpr(type == BinaryLogArgType::String)
+        {
+            std::string_view text(value);
+            uint16_t length = static_cast<uint16_t>(std::min<size_t>(text.size(), BINARY_LOG_MAX_STRING));
+
+            buffer.Put(position, &length, sizeof(length));
+            buffer.Put(position, text.data(), length);
+        }
+        else if constexpr(type == BinaryLogArgType::Double)
+        {
+            double number = static_cast<double>(value);
+            buffer.Put(position, &number, sizeof(number));
+        }
+        else
+        {
+            uint64_t number = static_cast<uint64_t>(value);
+            buffer.Put(position, &number, sizeof(number));
+        }
+    }
+
+private:
+    // 256KB per thread, allocated on the thread's first record
+    static constexpr uint32_t THREAD_CAPACITY_LOG2 = 18;
+
+    inline static std::atomic<bool> s_Active = false;
+    inline static thread_local BinaryLogThreadBuffer* t_Buffer = nullptr;
+
+    std::chrono::steady_clock::time_point m_Epoch;
+
+    // Guards the buffer list, the pending sites and the file, never the recording itself
+    std::mutex m_Mutex;
+    std::vector<std::unique_ptr<BinaryLogThreadBuffer>> m_Threads;
+    // Every site registered so far, a newly opened file gets all of them again
+    std::vector<std::vector<uint8_t>> m_Sites;
+    size_t m_WrittenSites;
+    std::ofstream m_File;
+    uint64_t m_ReportedDropped;
+
+    std::atomic<bool> m_Running;
+    std::thread m_Thread;
+};
+
+// BINLOG_INFO(Frame, "Frame {} took {} ms", frameNumber, milliseconds). The format has to be a literal,
+// {} is replaced by the next argument when decoding. Filtered like LOG_*, and free when no log is open
+#define BINLOG_AT(level, category, format, ...) \
+    do \
+    { \
+        if constexpr(LogIsCompiledIn(LogLevel::level, LogCategory::category)) \
+        { \
+            if(BinaryLog::IsActive() && LogFilter::IsEnabled(LogLevel::level, LogCategory::category)) \
+            { \
+                static BinaryLogSite binaryLogSite{ BinaryLogHash(__FILE__ "|" format, __LINE__), LogLevel::level, LogCategory::category, __FILE__, __LINE__, format }; \
+                BinaryLog::Get().Write(binaryLogSite __VA_OPT__(,) __VA_ARGS__); \
+            } \
+        } \
+    } while(0)
+
+#define BINLOG_TRACE(category, format, ...) BINLOG_AT(Trace, category, format __VA_OPT__(,) __VA_ARGS__)
+#define BINLOG_DEBUG(category, format, ...) BINLOG_AT(Debug, category, format __VA_OPT__(,) __VA_ARGS__)
+#define BINLOG_INFO(category, format, ...) BINLOG_AT(Info, category, format __VA_OPT__(,) __VA_ARGS__)
+#define BINLOG_WARN(category, format, ...) BINLOG_AT(Warn, category, format __VA_OPT__(,) __VA_ARGS__)
+#define BINLOG_ERROR(category, format, ...) BINLOG_AT(Error, category, format __VA_OPT__(,) __VA_ARGS__)
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+// Layout of the files BinaryLog writes, shared with the decoder. Everything is little endian.
+//
+// The file starts with BINARY_LOG_MAGIC followed by blocks, each opening with a one byte tag:
+//   Site         uint32 id, uint8 level, uint32 category, uint32 line, uint16 + bytes file,
+//                uint16 + bytes format, uint8 argument count, one BinaryLogArgType per argument
+//   Calibration  uint64 ticks, uint64 nanoseconds since the log was opened
+//   Records      uint32 thread id, uint32 byte count, then that many bytes of records
+//   Dropped      uint64 records dropped so far because a thread's buffer was full
+//
+// A record is uint32 site id and the arguments of the site. Numbers take eight bytes, strings a uint16 length
+// and the bytes. A site block always comes before its first record, so a file cut short by a crash still
+// decodes up to the last complete block.
+//
+// Reading the clock costs more than the rest of a record, so records don't carry a time of their own. A thread
+// writes BINARY_LOG_TIMESTAMP_ID and uint64 ticks in place of a record every BINARY_LOG_TIMESTAMP_INTERVAL
+// records and after every drain, the records following it are numbered from 0 in the order they were written
+inline constexpr char BINARY_LOG_MAGIC[8] = { 'V', 'K', 'T', 'B', 'L', 'O', 'G', '2' };
+
+// Site ids never hash to it
+inline constexpr uint32_t BINARY_LOG_TIMESTAMP_ID = 0;
+inline constexpr uint32_t BINARY_LOG_TIMESTAMP_INTERVAL = 32;
+
+enum class BinaryLogBlock : uint8_t
+{
+    Site = 'S',
+    Calibration = 'C',
+    Records = 'R',
+    Dropped = 'D'
+};
+
+enum class BinaryLogArgType : uint8_t
+{
+    Int64,
+    UInt64,
+    Double,
+    Bool,
+    String
+};
+
+// Longer strings are cut off
+inline constexpr uint16_t BINARY_LOG_MAX_STRING = 1024;
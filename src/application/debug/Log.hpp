@@ -1,8 +1,133 @@
 #pragma once
+#include "AsyncLogWriter.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
 #include <iostream>
+#include <sstream>
+#include <string>
+
+// Build time filtering. Override with -DLOG_MIN_LEVEL=LOG_LEVEL_WARN and -DLOG_CATEGORY_MASK=...
+// Calls filtered out here compile to nothing, their arguments are never evaluated
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_WARN 3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF 5
+
+#ifndef LOG_MIN_LEVEL
+    #ifdef NDEBUG
+        #define LOG_MIN_LEVEL LOG_LEVEL_INFO
+    #else
+        #define LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+    #endif
+#endif
+
+#ifndef LOG_CATEGORY_MASK
+    #define LOG_CATEGORY_MASK 0xFFFFFFFFu
+#endif
+
+enum class LogCategory : uint32_t
+{
+    General = 1 << 0,
+
+    // Wrapper objects being created and destroyed
+    VulkanLifetime = 1 << 1,
+    Swapchain = 1 << 2,
+    DeviceSelection = 1 << 3,
+
+    // Per frame tracing, only compiled in with LOG_MIN_LEVEL at LOG_LEVEL_TRACE
+    Frame = 1 << 4
+};
+
+inline constexpr uint32_t LOG_CATEGORY_COUNT = 5;
+
+constexpr bool LogIsCompiledIn(LogLevel level, LogCategory category)
+{
+    return static_cast<int>(level) >= LOG_MIN_LEVEL && (static_cast<uint32_t>(category) & LOG_CATEGORY_MASK) != 0;
+}
+
+// Runtime filter on top of the build time one, per category. It can only hold back what was compiled in
+class LogFilter
+{
+public:
+    static void SetLevel(LogCategory category, LogLevel level) { s_Levels[Index(category)].store(level, std::memory_order_relaxed); }
+    static LogLevel GetLevel(LogCategory category) { return s_Levels[Index(category)].load(std::memory_order_relaxed); }
+
+    static bool IsEnabled(LogLevel level, LogCategory category) { return level >= GetLevel(category); }
+
+    // Takes "category=level", ie. "swapchain=warn" or "frame=trace". Returns false if either name is unknown
+    static bool ParseOverride(const std::string& text);
+
+    static const char* GetCategoryName(LogCategory category);
+    static const char* GetLevelName(LogLevel level);
+
+private:
+    static constexpr uint32_t Index(LogCategory category) { return std::countr_zero(static_cast<uint32_t>(category)); }
 
-#define DEBUG
-//#undef DEBUG
+    // Everything that was compiled in passes until overridden
+    inline static std::atomic<LogLevel> s_Levels[LOG_CATEGORY_COUNT] = {};
+};
+
+inline bool LogFilter::ParseOverride(const std::string& text)
+{
+    size_t separator = text.find('=');
+    if(separator == std::string::npos)
+        return false;
+
+    std::string categoryName = text.substr(0, separator);
+    std::string levelName = text.substr(separator + 1);
+
+    for(uint32_t categoryIndex = 0; categoryIndex < LOG_CATEGORY_COUNT; categoryIndex++)
+    {
+        LogCategory category = static_cast<LogCategory>(1u << categoryIndex);
+        if(categoryName != GetCategoryName(category))
+            continue;
+
+        for(uint8_t levelIndex = 0; levelIndex <= static_cast<uint8_t>(LogLevel::Off); levelIndex++)
+        {
+            LogLevel level = static_cast<LogLevel>(levelIndex);
+            if(levelName == GetLevelName(level))
+            {
+                SetLevel(category, level);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+inline const char* LogFilter::GetCategoryName(LogCategory category)
+{
+    switch(category)
+    {
+        case LogCategory::General: return "general";
+        case LogCategory::VulkanLifetime: return "vulkan-lifetime";
+        case LogCategory::Swapchain: return "swapchain";
+        case LogCategory::DeviceSelection: return "device-selection";
+        case LogCategory::Frame: return "frame";
+    }
+
+    return "unknown";
+}
+
+inline const char* LogFilter::GetLevelName(LogLevel level)
+{
+    switch(level)
+    {
+        case LogLevel::Trace: return "trace";
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info: return "info";
+        case LogLevel::Warn: return "warn";
+        case LogLevel::Error: return "error";
+        case LogLevel::Off: return "off";
+    }
+
+    return "unknown";
+}
 
 template<typename OutputStreamT>
 class LoggerBase
@@ -13,33 +138,83 @@ public:
     template<typename ... Args>
     void Info(Args&& ... args)
     {
-        LogBase("Info", std::forward<Args>(args)...);
+        Write<LogLevel::Info, LogCategory::General>(std::forward<Args>(args)...);
     }
     
     template<typename ... Args>
     void Warn(Args&& ... args)
     {
-        LogBase("Warn", std::forward<Args>(args)...);
+        Write<LogLevel::Warn, LogCategory::General>(std::forward<Args>(args)...);
     }
 
     template<typename ... Args>
     void Error(Args&& ... args)
     {
-        LogBase("Error", std::forward<Args>(args)...);
+        Write<LogLevel::Error, LogCategory::General>(std::forward<Args>(args)...);
+    }
+
+    // The LOG_* macros below land here. Called directly the arguments are still evaluated, filtered out or not
+    template<LogLevel Level, LogCategory Category, typename ... Args>
+    void Write(Args&& ... args)
+    {
+        if constexpr(LogIsCompiledIn(Level, Category))
+        {
+            if(LogFilter::IsEnabled(Level, Category))
+                LogBase(Level, Category, std::forward<Args>(args)...);
+        }
     }
 
 private:
-    template<typename Category, typename ... Args>
-    void LogBase(const Category& category, Args&& ... args)
+    // The line is formatted into a per thread stream, the writer thread does the actual output
+    template<typename ... Args>
+    void LogBase(LogLevel level, LogCategory category, Args&& ... args)
+    {
+        thread_local std::ostringstream line;
+        line.str(std::string());
+        line.clear();
+
+        line << LevelPrefix(level);
+        if(category != LogCategory::General)
+            line << " [" << LogFilter::GetCategoryName(category) << "]";
+        line << ": ";
+
+        ((line << std::forward<Args>(args)), ...) << "\n";
+
+        AsyncLogWriter::Get().Push(m_OutputStream, level, line.str());
+    }
+
+    static const char* LevelPrefix(LogLevel level)
     {
-        #ifdef DEBUG
-            m_OutputStream << category << ": ";
-            ((m_OutputStream << std::forward<Args>(args)), ...) << "\n";
-        #endif
+        switch(level)
+        {
+            case LogLevel::Trace: return "Trace";
+            case LogLevel::Debug: return "Debug";
+            case LogLevel::Info: return "Info";
+            case LogLevel::Warn: return "Warn";
+            default: return "Error";
+        }
     }
 
 private:
     OutputStreamT& m_OutputStream;
 };
 
-inline static LoggerBase<std::ostream> Log(std::cout);
\ No newline at end of file
+inline static LoggerBase<std::ostream> Log(std::cout);
+
+// LOG_INFO(Swapchain, "Recreated ", extent.width, "x", extent.height). When the level or category is
+// filtered out at build time the whole statement, arguments included, disappears
+#define LOG_AT(level, category, ...) \
+    do \
+    { \
+        if constexpr(LogIsCompiledIn(LogLevel::level, LogCategory::category)) \
+        { \
+            if(LogFilter::IsEnabled(LogLevel::level, LogCategory::category)) \
+                Log.Write<LogLevel::level, LogCategory::category>(__VA_ARGS__); \
+        } \
+    } while(0)
+
+#define LOG_TRACE(category, ...) LOG_AT(Trace, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) LOG_AT(Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) LOG_AT(Info, category, __VA_ARGS__)
+#define LOG_WARN(category, ...) LOG_AT(Warn, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) LOG_AT(Error, category, __VA_ARGS__)
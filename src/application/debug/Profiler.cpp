@@ -0,0 +1,131 @@
+#include "Profiler.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+void ProfilerThreadBuffer::Snapshot(std::vector<ProfilerZoneEvent>& events) const
+{
+    uint64_t capacity = m_Mask + 1;
+
+    uint64_t head = m_Head.load(std::memory_order_acquire);
+    uint64_t first = head > capacity ? head - capacity : 0;
+
+    size_t offset = events.size();
+    for(uint64_t i = first; i < head; i++)
+        events.push_back(m_Events[i & m_Mask]);
+
+    // Anything the owner lapped while copying may be torn, including the slot of the event it's writing right now
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t headAfter = m_Head.load(std::memory_order_relaxed);
+    uint64_t firstIntact = headAfter + 1 > capacity ? headAfter + 1 - capacity : 0;
+
+    if(firstIntact > first)
+    {
+        size_t torn = static_cast<size_t>(std::min(firstIntact - first, head - first));
+        events.erase(events.begin() + offset, events.begin() + offset + torn);
+    }
+}
+
+Profiler& Profiler::Get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : m_Enabled(true), m_Epoch(std::chrono::steady_clock::now())
+{
+}
+
+void Profiler::SetThreadName(const std::string& name)
+{
+    ProfilerThreadBuffer& buffer = GetThreadBuffer();
+
+    std::lock_guard lock(m_Mutex);
+    buffer.m_ThreadName = name;
+}
+
+ProfilerThreadBuffer& Profiler::GetThreadBuffer()
+{
+    thread_local ProfilerThreadBuffer* buffer = nullptr;
+
+    // Buffers outlive their threads so zones of finished threads still make it into the trace
+    if(!buffer)
+    {
+        std::lock_guard lock(m_Mutex);
+
+        m_Threads.emplace_back(std::make_unique<ProfilerThreadBuffer>(static_cast<uint32_t>(m_Threads.size() + 1), THREAD_CAPACITY_LOG2));
+        buffer = m_Threads.back().get();
+    }
+
+    return *buffer;
+}
+
+static void WriteJsonString(std::ofstream& file, const char* text)
+{
+    file << '"';
+
+    for(const char* c = text; *c; c++)
+    {
+        if(*c == '"' || *c == '\\')
+            file << '\\';
+
+        file << *c;
+    }
+
+    file << '"';
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if(!file.is_open())
+    {
+        Log.Error("Profiler failed to open ", path);
+        return false;
+    }
+
+    // Timestamps are in microseconds
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    size_t zoneCount = 0;
+    std::vector<ProfilerZoneEvent> events;
+
+    std::lock_guard lock(m_Mutex);
+
+    for(const std::unique_ptr<ProfilerThreadBuffer>& buffer : m_Threads)
+    {
+        if(!buffer->m_ThreadName.empty())
+        {
+            file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->GetThreadId() << ",\"args\":{\"name\":";
+            WriteJsonString(file, buffer->m_ThreadName.c_str());
+            file << "}}";
+            first = false;
+        }
+
+        events.clear();
+        buffer->Snapshot(events);
+
+        for(const ProfilerZoneEvent& event : events)
+        {
+            file << (first ? "" : ",\n") << "{\"name\":";
+            WriteJsonString(file, event.Name);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->GetThreadId()
+                << ",\"ts\":" << event.StartNanoseconds / 1000.0
+                << ",\"dur\":" << event.DurationNanoseconds / 1000.0 << "}";
+            first = false;
+        }
+
+        zoneCount += events.size();
+    }
+
+    file << "\n]}\n";
+
+    Log.Info("Profiler wrote ", zoneCount, " zones from ", m_Threads.size(), " threads to ", path);
+    return true;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ProfilerZoneEvent
+{
+    // Zone names are string literals, only the pointer is recorded
+    const char* Name;
+    uint64_t StartNanoseconds;
+    uint64_t DurationNanoseconds;
+};
+
+// Zones recorded by a single thread. Only the owning thread writes, once full the oldest zones are overwritten
+class ProfilerThreadBuffer
+{
+public:
+    ProfilerThreadBuffer(uint32_t threadId, uint32_t capacityLog2)
+        : m_ThreadId(threadId), m_Mask((1ull << capacityLog2) - 1), m_Events(1ull << capacityLog2), m_Head(0) {}
+
+    void Push(const char* name, uint64_t start, uint64_t duration)
+    {
+        uint64_t head = m_Head.load(std::memory_order_relaxed);
+        m_Events[head & m_Mask] = { name, start, duration };
+        m_Head.store(head + 1, std::memory_order_release);
+    }
+
+    // Copies the zones still in the buffer, oldest first. Safe while the owner keeps recording,
+    // zones it overwrote during the copy are dropped
+    void Snapshot(std::vector<ProfilerZoneEvent>& events) const;
+
+    uint32_t GetThreadId() const { return m_ThreadId; }
+
+private:
+    friend class Profiler;
+
+    uint32_t m_ThreadId;
+    std::string m_ThreadName;
+
+    uint64_t m_Mask;
+    std::vector<ProfilerZoneEvent> m_Events;
+
+    // Total zones pushed, the next one goes to m_Head & m_Mask
+    std::atomic<uint64_t> m_Head;
+};
+
+// Records named, nested CPU zones into per thread ring buffers and writes them out as a Chrome trace,
+// which chrome://tracing and Perfetto both open. Recording a zone takes two clock reads and a store,
+// no locks, so zones can stay in release builds
+class Profiler
+{
+public:
+    static Profiler& Get();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void SetEnabled(bool enabled) { m_Enabled.store(enabled, std::memory_order_relaxed); }
+    bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+    // Shown instead of the thread id in the trace viewer
+    void SetThreadName(const std::string& name);
+
+    // Nanoseconds since the profiler was created
+    uint64_t Now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Epoch).count();
+    }
+
+    void Record(const char* name, uint64_t start, uint64_t end)
+    {
+        GetThreadBuffer().Push(name, start, end - start);
+    }
+
+    // Writes every zone still buffered, may be called at any time from any thread
+    bool WriteChromeTrace(const std::string& path);
+
+private:
+    Profiler();
+
+    ProfilerThreadBuffer& GetThreadBuffer();
+
+private:
+    // 16k zones per thread, about 400KB. Allocated on the thread's first zone
+    static constexpr uint32_t THREAD_CAPACITY_LOG2 = 14;
+
+    std::atomic<bool> m_Enabled;
+    std::chrono::steady_clock::time_point m_Epoch;
+
+    // Guards the list of buffers and their names, never the recording itself
+    std::mutex m_Mutex;
+    std::vector<std::unique_ptr<ProfilerThreadBuffer>> m_Threads;
+};
+
+// Times its own lifetime as a zone named |name|
+class ProfilerZone
+{
+public:
+    ProfilerZone(const char* name)
+        : m_Name(Profiler::Get().IsEnabled() ? name : nullptr), m_Start(m_Name ? Profiler::Get().Now() : 0) {}
+
+    ~ProfilerZone()
+    {
+        End();
+    }
+
+    // Ends the zone before the scope does
+    void End()
+    {
+        if(m_Name)
+            Profiler::Get().Record(m_Name, m_Start, Profiler::Get().Now());
+
+        m_Name = nullptr;
+    }
+
+    ProfilerZone(const ProfilerZone&) = delete;
+    ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+private:
+    const char* m_Name;
+    uint64_t m_Start;
+};
+
+#define PROFILE_ZONE_CONCAT_INNER(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_INNER(a, b)
+
+// Times the rest of the enclosing scope
+#define PROFILE_ZONE(name) ProfilerZone PROFILE_ZONE_CONCAT(profilerZone, __LINE__)(name)
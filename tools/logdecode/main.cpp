@@ -0,0 +1,381 @@
+#include "application/debug/BinaryLogFormat.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Turns a binary log written by BinaryLog back into text, one line per record:
+//   [  12.345678 ms] Info [frame] Application.cpp:300 (thread 1): Frame 3 took 16.6 ms
+// Records written after their thread's last timestamp get that time and how many records came after it:
+//   [  12.345678 ms +2] Info [frame] Application.cpp:300 (thread 1): Frame 5 took 16.6 ms
+// Usage: vulkan-triangle-logdecode <binary log> [output file]
+
+struct DecoderSite
+{
+    uint8_t Level = 0;
+    uint32_t Category = 0;
+    uint32_t Line = 0;
+    std::string File;
+    std::string Format;
+    std::vector<BinaryLogArgType> ArgTypes;
+};
+
+struct DecoderRecord
+{
+    uint32_t ThreadId;
+    uint64_t Ticks;
+
+    // Records since the timestamp Ticks comes from
+    uint32_t Sequence;
+    std::string Text;
+};
+
+// Last timestamp of a thread, it carries over from one records block to the next
+struct ThreadClock
+{
+    uint64_t Ticks = 0;
+    uint32_t Sequence = 0;
+};
+
+struct Calibration
+{
+    uint64_t Ticks;
+    uint64_t Nanoseconds;
+};
+
+class Reader
+{
+public:
+    Reader(const std::vector<uint8_t>& data, size_t begin, size_t end) : m_Data(data), m_Position(begin), m_End(end) {}
+
+    bool HasMore() const { return m_Position < m_End; }
+    size_t GetPosition() const { return m_Position; }
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        if(m_End - m_Position < sizeof(T))
+            return false;
+
+        std::memcpy(&value, m_Data.data() + m_Position, sizeof(T));
+        m_Position += sizeof(T);
+
+        return true;
+    }
+
+    bool ReadString(std::string& text)
+    {
+        uint16_t length;
+        if(!Read(length) || m_End - m_Position < length)
+            return false;
+
+        text.assign(reinterpret_cast<const char*>(m_Data.data() + m_Position), length);
+        m_Position += length;
+
+        return true;
+    }
+
+    bool Skip(size_t count)
+    {
+        if(m_End - m_Position < count)
+            return false;
+
+        m_Position += count;
+        return true;
+    }
+
+private:
+    const std::vector<uint8_t>& m_Data;
+    size_t m_Position;
+    size_t m_End;
+};
+
+static const char* LevelName(uint8_t level)
+{
+    static const char* names[] = { "Trace", "Debug", "Info", "Warn", "Error" };
+    return level < 5 ? names[level] : "Unknown";
+}
+
+static const char* CategoryName(uint32_t category)
+{
+    switch(category)
+    {
+        case 1 << 0: return "general";
+        case 1 << 1: return "vulkan-lifetime";
+        case 1 << 2: return "swapchain";
+        case 1 << 3: return "device-selection";
+        case 1 << 4: return "frame";
+    }
+
+    return "unknown";
+}
+
+static bool ReadArgument(Reader& reader, BinaryLogArgType type, std::ostream& out)
+{
+    if(type == BinaryLogArgType::String)
+    {
+        std::string text;
+        if(!reader.ReadString(text))
+            return false;
+
+        out << text;
+        return true;
+    }
+
+    uint64_t bits;
+    if(!reader.Read(bits))
+        return false;
+
+    switch(type)
+    {
+        case BinaryLogArgType::Int64: out << static_cast<int64_t>(bits); break;
+        case BinaryLogArgType::UInt64: out << bits; break;
+        case BinaryLogArgType::Bool: out << (bits ? "true" : "false"); break;
+        case BinaryLogArgType::Double:
+        {
+            double number;
+            std::memcpy(&number, &bits, sizeof(number));
+            out << number;
+        } break;
+        default: break;
+    }
+
+    return true;
+}
+
+// Fills in the site's format with the record's arguments
+static bool DecodeRecord(Reader& reader, const DecoderSite& site, std::string& text)
+{
+    std::ostringstream out;
+    size_t argument = 0;
+
+    for(size_t i = 0; i < site.Format.size(); i++)
+    {
+        if(site.Format[i] == '{' && i + 1 < site.Format.size() && site.Format[i + 1] == '}' && argument < site.ArgTypes.size())
+        {
+            if(!ReadArgument(reader, site.ArgTypes[argument++], out))
+                return false;
+
+            i++;
+        }
+        else
+        {
+            out << site.Format[i];
+        }
+    }
+
+    // Arguments without a placeholder still have to be consumed, they are appended
+    for(; argument < site.ArgTypes.size(); argument++)
+    {
+        out << ' ';
+        if(!ReadArgument(reader, site.ArgTypes[argument], out))
+            return false;
+    }
+
+    text = out.str();
+    return true;
+}
+
+static std::string BaseName(const std::string& path)
+{
+    size_t separator = path.find_last_of("/\\");
+    return separator == std::string::npos ? path : path.substr(separator + 1);
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <binary log> [output file]\n";
+        return (EXIT_FAILURE);
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    if(!file.is_open())
+    {
+        std::cerr << "Failed to open " << argv[1] << "\n";
+        return (EXIT_FAILURE);
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if(data.size() < sizeof(BINARY_LOG_MAGIC) || std::memcmp(data.data(), BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC)) != 0)
+    {
+        std::cerr << argv[1] << " is not a binary log\n";
+        return (EXIT_FAILURE);
+    }
+
+    std::unordered_map<uint32_t, DecoderSite> sites;
+    std::unordered_map<uint32_t, ThreadClock> clocks;
+    std::vector<DecoderRecord> records;
+    std::vector<Calibration> calibrations;
+    uint64_t dropped = 0;
+    bool truncated = false;
+
+    Reader reader(data, sizeof(BINARY_LOG_MAGIC), data.size());
+    while(reader.HasMore() && !truncated)
+    {
+        uint8_t tag = 0;
+        reader.Read(tag);
+
+        switch(static_cast<BinaryLogBlock>(tag))
+        {
+            case BinaryLogBlock::Site:
+            {
+                uint32_t id;
+                DecoderSite site;
+                uint8_t argCount;
+
+                truncated = !(reader.Read(id) && reader.Read(site.Level) && reader.Read(site.Category) && reader.Read(site.Line)
+                    && reader.ReadString(site.File) && reader.ReadString(site.Format) && reader.Read(argCount));
+
+                for(uint8_t i = 0; i < argCount && !truncated; i++)
+                {
+                    BinaryLogArgType type;
+                    truncated = !reader.Read(type);
+                    site.ArgTypes.push_back(type);
+                }
+
+                if(!truncated)
+                    sites[id] = std::move(site);
+            } break;
+            case BinaryLogBlock::Calibration:
+            {
+                Calibration calibration;
+                truncated = !(reader.Read(calibration.Ticks) && reader.Read(calibration.Nanoseconds));
+
+                if(!truncated)
+                    calibrations.push_back(calibration);
+            } break;
+            case BinaryLogBlock::Records:
+            {
+                uint32_t threadId;
+                uint32_t size;
+                truncated = !(reader.Read(threadId) && reader.Read(size));
+
+                if(truncated)
+                    break;
+
+                size_t begin = reader.GetPosition();
+                if(!reader.Skip(size))
+                {
+                    truncated = true;
+                    break;
+                }
+
+                ThreadClock& clock = clocks[threadId];
+
+                Reader recordReader(data, begin, begin + size);
+                while(recordReader.HasMore())
+                {
+                    uint32_t siteId;
+                    if(!recordReader.Read(siteId))
+                        break;
+
+                    if(siteId == BINARY_LOG_TIMESTAMP_ID)
+                    {
+                        if(!recordReader.Read(clock.Ticks))
+                            break;
+
+                        clock.Sequence = 0;
+                        continue;
+                    }
+
+                    DecoderRecord record;
+                    record.ThreadId = threadId;
+                    record.Ticks = clock.Ticks;
+                    record.Sequence = clock.Sequence++;
+
+                    auto site = sites.find(siteId);
+                    if(site == sites.end())
+                    {
+                        // Without the site the record's size is unknown, the rest of the block is lost
+                        std::cerr << "Unknown site " << siteId << ", skipping the rest of a block\n";
+                        break;
+                    }
+
+                    if(!DecodeRecord(recordReader, site->second, record.Text))
+                        break;
+
+                    record.Text = std::string(LevelName(site->second.Level)) + " [" + CategoryName(site->second.Category) + "] "
+                        + BaseName(site->second.File) + ":" + std::to_string(site->second.Line)
+                        + " (thread " + std::to_string(threadId) + "): " + record.Text;
+
+                    records.push_back(std::move(record));
+                }
+            } break;
+            case BinaryLogBlock::Dropped:
+            {
+                truncated = !reader.Read(dropped);
+            } break;
+            default:
+            {
+                std::cerr << "Unknown block tag " << static_cast<int>(tag) << ", stopping\n";
+                truncated = true;
+            } break;
+        }
+    }
+
+    if(truncated)
+        std::cerr << "Log ends in an incomplete block, it was probably cut short\n";
+
+    // Ticks to time, from the first and the last calibration point
+    double nanosecondsPerTick = 1.0;
+    uint64_t baseTicks = 0;
+    uint64_t baseNanoseconds = 0;
+
+    if(!calibrations.empty())
+    {
+        const Calibration& first = calibrations.front();
+        const Calibration& last = calibrations.back();
+
+        baseTicks = first.Ticks;
+        baseNanoseconds = first.Nanoseconds;
+
+        if(last.Ticks > first.Ticks)
+            nanosecondsPerTick = static_cast<double>(last.Nanoseconds - first.Nanoseconds) / static_cast<double>(last.Ticks - first.Ticks);
+    }
+
+    // Blocks come per thread, interleave them back into one timeline. Records sharing a timestamp are from
+    // the same thread and stay in the order they were written
+    std::stable_sort(records.begin(), records.end(), [](const DecoderRecord& lhs, const DecoderRecord& rhs)
+    {
+        return lhs.Ticks < rhs.Ticks;
+    });
+
+    std::ofstream outputFile;
+    if(argc > 2)
+    {
+        outputFile.open(argv[2]);
+        if(!outputFile.is_open())
+        {
+            std::cerr << "Failed to open " << argv[2] << " for writing\n";
+            return (EXIT_FAILURE);
+        }
+    }
+
+    std::ostream& output = outputFile.is_open() ? outputFile : std::cout;
+    output.setf(std::ios::fixed);
+    output.precision(6);
+
+    for(const DecoderRecord& record : records)
+    {
+        double milliseconds = (baseNanoseconds + (static_cast<double>(record.Ticks) - static_cast<double>(baseTicks)) * nanosecondsPerTick) / 1e6;
+        output << "[" << milliseconds << " ms";
+
+        if(record.Sequence > 0)
+            output << " +" << record.Sequence;
+
+        output << "] " << record.Text << "\n";
+    }
+
+    if(dropped > 0)
+        output << dropped << " records were dropped because a thread's buffer was full\n";
+
+    return (EXIT_SUCCESS);
+}